@@ -0,0 +1,94 @@
+#include "chess.h"
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+
+// batch analyzer class implementation
+
+// constructor of batch analyzer class
+BatchAnalyzer::BatchAnalyzer(const unsigned short &threads, const size_t &hash_megabytes, const bool &ordered) noexcept
+: threads(std::max<unsigned short>(threads, 1)), hash_megabytes(hash_megabytes), ordered(ordered) {	}
+
+// analyzes every job "next_job" hands out until it returns false and passes each result to "result", returns the number of positions analyzed,
+// the jobs are read on the calling thread into a short queue the idle workers take the next job from, so a slow position never holds up the
+// others and the input is never read much ahead of the workers, "result" is called by one thread at a time, the results of an ordered batch
+// that finish early wait until the results before them are handed out, every job starts with a cleared transposition table and a random
+// number generator seeded with its index so its result does not depend on which worker searched it or what it searched before
+unsigned long long BatchAnalyzer::Run(const std::function<bool(BatchJob&)> &next_job, const std::function<void(const BatchResult&)> &result) noexcept {
+	std::mutex queue_mutex, result_mutex;
+	std::condition_variable queue_changed;
+	std::deque<BatchJob> queue;
+	bool input_finished = false;
+	std::map<unsigned long long, BatchResult> waiting_results;		// the results of an ordered batch that finished before the ones before them
+	unsigned long long next_result = 0;
+	auto HandOut = [&](const BatchResult &job_result) {
+		std::lock_guard<std::mutex> lock(result_mutex);
+		if(!ordered) {
+			result(job_result);
+			return;
+		}
+		waiting_results.emplace(job_result.index, job_result);
+		for(auto it = waiting_results.begin(); it != waiting_results.end() && it->first == next_result; it = waiting_results.erase(it), ++next_result)
+			result(it->second);
+	};
+	std::vector<std::thread> workers;
+	for(unsigned short i=0;i<threads;++i)
+		workers.emplace_back([&]() {
+			Chess c("White", 1, "Black", 1);
+			Bot bot("Batch", 1);
+			bot.GetTranspositionTable().Resize(hash_megabytes);
+			SearchReport last_report;
+			bot.SetReport([&last_report](const SearchReport &report) { last_report = report; });
+			while(true) {
+				BatchJob job;
+				{
+					std::unique_lock<std::mutex> lock(queue_mutex);
+					queue_changed.wait(lock, [&]() { return !queue.empty() || input_finished; });
+					if(queue.empty())
+						return;
+					job = std::move(queue.front());
+					queue.pop_front();
+				}
+				queue_changed.notify_all();
+				BatchResult job_result;
+				job_result.index = job.index;
+				job_result.fen = std::move(job.fen);
+				job_result.tag = std::move(job.tag);
+				if((job_result.valid = c.LoadFEN(job_result.fen))) {
+					bot.GetTranspositionTable().Clear();
+					c.SeedRandom(job.index);
+					last_report = SearchReport();
+					const auto &start = std::chrono::steady_clock::now();
+					job_result.best_move = bot.GetIdealMove(c, job.limits);
+					job_result.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+					job_result.score = last_report.score;
+					job_result.depth = last_report.depth;
+					job_result.nodes = bot.GetNodes();
+				}
+				HandOut(job_result);
+			}
+		});
+	unsigned long long count = 0;
+	for(BatchJob job;;++count) {
+		job.index = count;
+		if(!next_job(job))
+			break;
+		std::unique_lock<std::mutex> lock(queue_mutex);
+		queue_changed.wait(lock, [&]() { return queue.size() < 2u * threads; });
+		queue.push_back(std::move(job));
+		lock.unlock();
+		queue_changed.notify_all();
+		job = BatchJob();
+	}
+	{
+		std::lock_guard<std::mutex> lock(queue_mutex);
+		input_finished = true;
+	}
+	queue_changed.notify_all();
+	for(auto &worker : workers)
+		worker.join();
+	return count;
+}
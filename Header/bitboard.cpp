@@ -0,0 +1,49 @@
+#include "chess.h"
+
+// bitboard implementation
+
+Bitboard KNIGHT_ATTACKS[BOARD_SIZE*BOARD_SIZE];
+Bitboard KING_ATTACKS[BOARD_SIZE*BOARD_SIZE];
+Bitboard PAWN_ATTACKS[2][BOARD_SIZE*BOARD_SIZE];
+Bitboard RAY_ATTACKS[8][BOARD_SIZE*BOARD_SIZE];
+Bitboard BETWEEN[BOARD_SIZE*BOARD_SIZE][BOARD_SIZE*BOARD_SIZE];
+Bitboard LINE[BOARD_SIZE*BOARD_SIZE][BOARD_SIZE*BOARD_SIZE];
+
+// fills the attack tables, the tables only depend on the board geometry so they are computed a single time
+bool InitBitboards() noexcept {
+	const short KNIGHT_DX[8] = {-2, -2, -1, -1, 1, 1, 2, 2}, KNIGHT_DY[8] = {-1, 1, -2, 2, -2, 2, -1, 1};
+	const short RAY_DX[8] = {0, 1, 0, -1, 1, 1, -1, -1}, RAY_DY[8] = {-1, 0, 1, 0, -1, 1, 1, -1};		// N, E, S, W, NE, SE, SW, NW
+	auto WithinBoard = [](const short &x, const short &y){ return x>=0 && x<BOARD_SIZE && y>=0 && y<BOARD_SIZE; };
+	auto Bit = [](const short &x, const short &y){ return Bitboard(1) << (y*BOARD_SIZE + x); };
+	for(short y=0;y<BOARD_SIZE;++y)
+		for(short x=0;x<BOARD_SIZE;++x) {
+			const short square = y*BOARD_SIZE + x;
+			KNIGHT_ATTACKS[square] = KING_ATTACKS[square] = PAWN_ATTACKS[0][square] = PAWN_ATTACKS[1][square] = 0;
+			for(short i=0;i<8;++i)
+				if(WithinBoard(x + KNIGHT_DX[i], y + KNIGHT_DY[i]))
+					KNIGHT_ATTACKS[square] |= Bit(x + KNIGHT_DX[i], y + KNIGHT_DY[i]);
+			for(short i=-1;i<2;++i)
+				for(short j=-1;j<2;++j)
+					if((i || j) && WithinBoard(x+i, y+j))
+						KING_ATTACKS[square] |= Bit(x+i, y+j);
+			for(short i=-1;i<2;i+=2) {
+				if(WithinBoard(x+i, y-1))	PAWN_ATTACKS[1][square] |= Bit(x+i, y-1);		// white pawns attack upwards
+				if(WithinBoard(x+i, y+1))	PAWN_ATTACKS[0][square] |= Bit(x+i, y+1);		// black pawns attack downwards
+			}
+			for(short dir=0;dir<8;++dir) {
+				RAY_ATTACKS[dir][square] = 0;
+				for(short i=x+RAY_DX[dir], j=y+RAY_DY[dir]; WithinBoard(i, j); i+=RAY_DX[dir], j+=RAY_DY[dir])
+					RAY_ATTACKS[dir][square] |= Bit(i, j);
+			}
+		}
+	for(short from=0;from<BOARD_SIZE*BOARD_SIZE;++from)		// needs the complete ray tables
+		for(short dir=0;dir<8;++dir)
+			for(Bitboard b = RAY_ATTACKS[dir][from]; b;) {
+				const short &to = PopLeastSignificantSquare(b);		// the opposite of direction "dir" is "dir ^ 2"
+				BETWEEN[from][to] = RAY_ATTACKS[dir][from] & RAY_ATTACKS[dir ^ 2][to];
+				LINE[from][to] = RAY_ATTACKS[dir][from] | RAY_ATTACKS[dir ^ 2][from] | (Bitboard(1) << from);
+			}
+	return true;
+}
+
+static const bool BITBOARDS_INITIALIZED = InitBitboards();
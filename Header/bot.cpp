@@ -1,26 +1,232 @@
-#include "chess.h"
-
-// bot class implementation
-
-// bot class constructor
-Bot::Bot(const std::string &name, const unsigned short &difficulty) noexcept : Player(name), difficulty(difficulty) {	}
-
-// getter method, returns the difficulty level of the bot
-unsigned short Bot::GetDifficulty() const noexcept {
-	return difficulty;
-}
-
-// returns the optimal move the bot can make with the default difficulty level (according to alpha-beta pruning at least)
-std::string Bot::GetIdealMove(Chess &c) noexcept {
-	return root.AlphaBetaRoot(c, difficulty);
-}
-
-// function overload, returns the optimal move the bot can make with the given difficulty level
-std::string Bot::GetIdealMove(Chess &c, unsigned short difficulty) noexcept {
-	return root.AlphaBetaRoot(c, difficulty);
-}
-
-// operator overload for '=='
-bool Bot::operator== (const Bot &b) const noexcept {
-	return !name.compare(b.name);	
-}
+#include "chess.h"
+#include <algorithm>
+#include <functional>
+#include <thread>
+
+// bot class implementation
+
+// bot class constructor
+Bot::Bot(const std::string &name, const unsigned short &difficulty) noexcept : Player(name), difficulty(difficulty) {	}
+
+// getter method, returns the difficulty level of the bot
+unsigned short Bot::GetDifficulty() const noexcept {
+	return difficulty;
+}
+
+// returns the bot's transposition table, allocates it with the configured size if the bot hasn't searched yet
+TranspositionTable& Bot::GetTranspositionTable() noexcept {
+	if(!tt)
+		tt = std::make_shared<TranspositionTable>(HASH_SIZE_MB);
+	return *tt;
+}
+
+// returns the bot's evaluation cache, allocates it if the bot hasn't searched yet
+EvaluationCache& Bot::GetEvaluationCache() noexcept {
+	if(!eval_cache)
+		eval_cache = std::make_shared<EvaluationCache>();
+	return *eval_cache;
+}
+
+// returns the optimal move the bot can make with the default difficulty level (according to alpha-beta pruning at least),
+// or the best move it finds in "move_time" seconds if it is set
+Move Bot::GetIdealMove(Chess &c) noexcept {
+	SearchLimits limits;
+	if(move_time)
+		limits.max_time = move_time;
+	else
+		limits.max_depth = difficulty + 1;		// the difficulty counts the moves after the bot's own move
+	return GetIdealMove(c, limits);
+}
+
+// function overload, returns the optimal move the bot can make with the given difficulty level
+Move Bot::GetIdealMove(Chess &c, unsigned short difficulty) noexcept {
+	SearchLimits limits;
+	limits.max_depth = difficulty + 1;
+	return GetIdealMove(c, limits);
+}
+
+// function overload, returns the best move the bot finds by searching deeper and deeper until one of the given limits is reached,
+// with more than one thread the helper threads search their own copies of the game without limits and fill the shared transposition table
+// for the main thread (lazy SMP), they are stopped when the main thread's search ends and the main thread's move is returned,
+// a book move is returned without searching if the bot has an opening book and the position is in it, and the move with the best tablebase result
+// if the bot has endgame tablebases and every move leads to a position in them, unless the search is infinite (analysis),
+// the search does not clear the stop flag, a search started after "Stop" without "ResetStop" in between only completes its first iteration
+Move Bot::GetIdealMove(Chess &c, const SearchLimits &limits) noexcept {
+	pawn_hash_probes = pawn_hash_hits = eval_cache_hits = eval_cache_misses = 0;		// stay zero if the move is not searched
+	if(book && !limits.infinite && 2*(c.GetFullmoveNumber()-1) + !c.GetTurn() < book_depth) {
+		const Move &book_move = book->Probe(c);
+		if(!book_move.IsNull()) {
+			nodes = 0;
+			ReportRootMove(book_move, 0);		// the book has no score, the opening is counted as balanced
+			return book_move;
+		}
+	}
+	if(tablebases && !limits.infinite) {
+		MoveList root_moves;
+		c.AllMoves(root_moves);
+		Move tablebase_move;
+		float best_score = -10000;
+		for(const auto &move : root_moves) {
+			float score;
+			c.MovePiece(move);
+			const bool &found = tablebases->Probe(c, score);
+			c.MovePieceBack(move);
+			if(!found) {
+				tablebase_move = Move();
+				break;
+			}
+			if(-score > best_score)
+				best_score = -score, tablebase_move = move;
+		}
+		if(!tablebase_move.IsNull()) {
+			nodes = 0;
+			ReportRootMove(tablebase_move, best_score > 0 ? best_score - 1 : best_score < 0 ? best_score + 1 : 0);		// the table counts the plies from after the move
+			return tablebase_move;
+		}
+	}
+	c.UseNetwork(network);				// the game may have been evaluated by the other bot
+	TranspositionTable &table = GetTranspositionTable();
+	table.NewSearch();
+	EvaluationCache &cache = GetEvaluationCache();
+	std::vector<SearchStack> &stacks = *search_stacks;
+	if(stacks.size() != threads)
+		stacks.assign(threads, SearchStack(MAX_PLY));
+	std::vector<PawnHashTable> &pawn_table_list = *pawn_tables;
+	if(pawn_table_list.size() != threads)
+		pawn_table_list.resize(threads);
+	for(auto &pawn_table : pawn_table_list)
+		pawn_table.ResetCounters();
+	std::atomic<bool> helpers_stop(false);
+	std::vector<SearchInfo> helper_infos(threads-1);
+	std::vector<std::thread> helpers;
+	for(unsigned short i=1;i<threads;++i) {
+		SearchInfo &helper_info = helper_infos[i-1];
+		helper_info.limits.infinite = true;
+		helper_info.stop = &helpers_stop;
+		helper_info.thread_index = i;
+		helper_info.tablebases = tablebases.get();
+		helper_info.pawn_table = &pawn_table_list[i];
+		helper_info.eval_cache = &cache;
+		helpers.emplace_back([&table, &helper_info](Chess position, SearchStack &stack) {
+			stack[0].IterativeDeepening(position, table, helper_info);
+		}, c, std::ref(stacks[i]));
+	}
+	SearchInfo info;
+	info.limits = limits;
+	info.stop = stop.get();
+	info.helpers = &helper_infos;
+	info.report = report;
+	info.tablebases = tablebases.get();
+	info.pawn_table = &pawn_table_list[0];
+	info.eval_cache = &cache;
+	const Move &best_move = stacks[0][0].IterativeDeepening(c, table, info);
+	helpers_stop.store(true);
+	nodes = info.nodes;
+	eval_cache_hits = info.eval_cache_hits;
+	eval_cache_misses = info.eval_cache_misses;
+	for(unsigned short i=1;i<threads;++i) {
+		helpers[i-1].join();
+		nodes += helper_infos[i-1].nodes;
+		eval_cache_hits += helper_infos[i-1].eval_cache_hits;
+		eval_cache_misses += helper_infos[i-1].eval_cache_misses;
+	}
+	pawn_hash_probes = pawn_hash_hits = 0;
+	for(const auto &pawn_table : pawn_table_list) {
+		pawn_hash_probes += pawn_table.GetProbes();
+		pawn_hash_hits += pawn_table.GetHits();
+	}
+	return best_move;
+}
+
+// reports the given move chosen without searching, from the opening book or the tablebases, and its score at depth zero if there is a report function
+void Bot::ReportRootMove(const Move &move, const float &score) const noexcept {
+	if(!report)
+		return;
+	SearchReport root_report;
+	root_report.score = score;
+	root_report.principal_variation.Add(move);
+	report(root_report);
+}
+
+// stops the running search of the bot, the search returns the best move of its last completed iteration
+void Bot::Stop() noexcept {
+	stop->store(true);
+}
+
+// clears the stop flag, called before a search is started so that a "Stop" sent at any time after this call is not lost
+void Bot::ResetStop() noexcept {
+	stop->store(false);
+}
+
+// returns the fraction of the pawn hash table lookups of the last search that found their entry, zero if there were none
+double Bot::GetPawnHashHitRate() const noexcept {
+	return pawn_hash_probes ? static_cast<double>(pawn_hash_hits) / pawn_hash_probes : 0;
+}
+
+// getter method, returns the number of evaluations the last search found in the evaluation cache, in all threads
+unsigned long long Bot::GetEvalCacheHits() const noexcept {
+	return eval_cache_hits;
+}
+
+// getter method, returns the number of evaluations the last search did not find in the evaluation cache, in all threads
+unsigned long long Bot::GetEvalCacheMisses() const noexcept {
+	return eval_cache_misses;
+}
+
+// getter method, returns the number of threads the bot searches with
+unsigned short Bot::GetThreads() const noexcept {
+	return threads;
+}
+
+// setter method, sets the number of threads the bot searches with
+void Bot::SetThreads(const unsigned short &thread_count) noexcept {
+	threads = std::max<unsigned short>(thread_count, 1);
+}
+
+// getter method, returns the number of seconds the bot searches per move, zero if it searches as deep as its difficulty
+double Bot::GetMoveTime() const noexcept {
+	return move_time;
+}
+
+// setter method, sets the number of seconds the bot searches per move, zero to search as deep as its difficulty
+void Bot::SetMoveTime(const double &seconds) noexcept {
+	move_time = std::max(seconds, 0.0);
+}
+
+// setter method, sets the function the main search thread calls after every completed iteration, an empty function turns the reports off
+void Bot::SetReport(const std::function<void(const SearchReport&)> &function) noexcept {
+	report = function;
+}
+
+// setter method, sets the opening book the bot plays from for the first "depth" halfmoves of the game, a null book turns the book off,
+// copies of the bot share the book
+void Bot::SetBook(const std::shared_ptr<const OpeningBook> &opening_book, const unsigned short &depth) noexcept {
+	book = opening_book;
+	book_depth = depth;
+}
+
+// setter method, sets the endgame tablebases the bot looks positions with few pieces up in, null tablebases turn them off,
+// copies of the bot share the tablebases
+void Bot::SetTablebases(const std::shared_ptr<const Tablebases> &endgame_tablebases) noexcept {
+	tablebases = endgame_tablebases;
+}
+
+// setter method, sets the neural network the bot evaluates positions with, the piece-square tables are used if it is null,
+// the evaluation cache is cleared since its scores came from the other evaluation
+void Bot::SetNetwork(const std::shared_ptr<const NeuralNetwork> &neural_network) noexcept {
+	if(network == neural_network)
+		return;
+	network = neural_network;
+	if(eval_cache)
+		eval_cache->Clear();
+}
+
+// getter method, returns the number of nodes the last search visited in all threads
+unsigned long long Bot::GetNodes() const noexcept {
+	return nodes;
+}
+
+// operator overload for '=='
+bool Bot::operator== (const Bot &b) const noexcept {
+	return !name.compare(b.name);	
+}
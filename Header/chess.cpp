@@ -1,898 +1,902 @@
-#include "chess.h"
-#include <iostream>
-#include <algorithm>
-#include <conio.h>
-#include <windows.h>
-
-// function definitions
-
-// moves the cursor to a different (x, y) location on the terminal
-void MoveCursorToXY(const short &x, const short &y) noexcept {
-	SetConsoleCursorPosition(GetStdHandle(STD_OUTPUT_HANDLE), (COORD){x, y});
-}
-
-// returns the given string in lowercase
-std::string ToLowerString(std::string s) noexcept {
-	transform(s.begin(), s.end(), s.begin(), [](const unsigned char &c){ return tolower(c); });
-	return s;
-}
-
-// returns a random number between "min" and "max"
-template<class T> T GetRandomNumber(const T &min, const T &max) noexcept {
-	return min + T(static_cast<double>(rand()) / static_cast<double>(RAND_MAX+1.0) * (max-min+1));
-}
-
-
-
-// chess class implementation
-
-// constructor of chess class
-Chess::Chess(const std::string &player1, const unsigned short &difficulty1, const std::string &player2, const unsigned short &difficulty2) noexcept
-: white(player1, difficulty1), black(player2, difficulty2) {
-	CopyBoard(STARTING_BOARD, board);
-}
-
-// checks whether the given coordinate is within board boundaries or not
-bool Chess::WithinBounds(const short &coord) noexcept {
-	return coord>=0 && coord<BOARD_SIZE;
-}
-
-// changes the given board coordinates from ASCII to numerical, e.g. ('d', '3') -> (3, 5)
-void Chess::ChangeToRealCoordinates(char &x1, char &y1, char &x2, char &y2) noexcept {
-	x1 -= 'a', x2 -= 'a';
-	y1 = '8'-y1, y2 = '8'-y2;
-}
-
-// changes the given board coordinates from numerical to ASCII, e.g. (3, 5) -> ('d', '3')
-void Chess::ChangeToString(char &x1, char &y1, char &x2, char &y2) noexcept {
-	x1 += 'a', x2 += 'a';
-	y1 = '8'-y1, y2 = '8'-y2;
-}
-
-// returns the given numerical board coordinates as a string
-std::string Chess::ToString(const short &x1, const short &y1, const short &x2, const short &y2) noexcept {
-	return {static_cast<char>(x1+'a'), static_cast<char>('8'-y1), static_cast<char>(x2+'a'), static_cast<char>('8'-y2)};
-}
-
-// returns the name that is displayed on the terminal for the given piece
-std::string Chess::PieceNameToString(const char &piece) noexcept {
-	switch(piece) {
-		case W_PAWN:	return "W_PAWN";
-		case B_PAWN:	return "B_PAWN";
-		case W_ROOK:	return "W_ROOK";
-		case B_ROOK:	return "B_ROOK";
-		case W_KNIGHT:	return "W_KNIGHT";
-		case B_KNIGHT:	return "B_KNIGHT";
-		case W_BISHOP:	return "W_BISHOP";
-		case B_BISHOP:	return "B_BISHOP";
-		case W_QUEEN:	return "W_QUEEN";
-		case B_QUEEN:	return "B_QUEEN";
-		case W_KING:	return "W_KING";
-		case B_KING:	return "B_KING";
-		default:		return "";
-	}
-}
-
-// returns the worth of the given piece in terms of points
-float Chess::EvaluatePiece(const char &piece) noexcept {
-	switch(piece) {
-		case W_PAWN:
-		case B_PAWN:	return 10;		// pawn: 10 points
-		case W_ROOK:
-		case B_ROOK:	return 50;		// rook: 50 points
-		case W_KNIGHT:
-		case B_KNIGHT:
-		case W_BISHOP:
-		case B_BISHOP:	return 30;		// knight and bishop: 30 points
-		case W_QUEEN:
-		case B_QUEEN:	return 90;		// queen: 90 points
-		case W_KING:
-		case B_KING:	return 900;		// king: 900 points, but you can assume it is infinite
-		default:		return 0;
-	}
-}
-
-// clears all available moves from the terminal
-void Chess::ClearAllMoves(const unsigned short &n) noexcept {
-	MoveCursorToXY(0, DOWN + 3*BOARD_SIZE + 9);
-	for(unsigned short i=0;i<n;++i)
-		std::cout << CLEAR_LINE << std::endl;
-}
-
-// prints the vertical seperators for the game board on the terminal
-void Chess::PrintSeparator(const char &ch) noexcept {
-	for(unsigned short i=1;i<BOARD_SIZE;++i)
-		std::cout << std::string(BOX_WIDTH, ch) << "|";
-	std::cout << std::string(BOX_WIDTH, ch) << std::endl << TO_RIGHT;
-}
-
-// copies the board contents of "from" to "to"
-void Chess::CopyBoard(const char from[BOARD_SIZE][BOARD_SIZE], char to[BOARD_SIZE][BOARD_SIZE]) noexcept {
-	std::copy(*from, *from + BOARD_SIZE*BOARD_SIZE, *to);
-}
-
-// checks whether the board positions of the given two boards are equal or not
-bool Chess::AreBoardsEqual(const char board1[BOARD_SIZE][BOARD_SIZE], const char board2[BOARD_SIZE][BOARD_SIZE]) noexcept {
-	return std::equal(*board1, *board1 + BOARD_SIZE*BOARD_SIZE, *board2);
-}
-
-bool Chess::CanMovePiece(const short &x1, const short &y1, const short &x2, const short &y2, const std::forward_list<std::string> &all_moves) noexcept {
-	return std::find(all_moves.cbegin(), all_moves.cend(), ToString(x1, y1, x2, y2)) != all_moves.cend();
-}
-
-// getter method, returns the piece located in the given x and y coordinates
-char Chess::GetPiece(const short &x, const short &y) const noexcept {
-//	CheckCoordinates(x, y, "GetPiece");
-	return board[y][x];
-}
-
-// getter method, returns whether it's team white's turn or not
-bool Chess::GetTurn() const noexcept {
-	return whites_turn;
-}
-
-// returns a reference to the player object
-Bot& Chess::GetCurrentPlayer() noexcept {
-	return whites_turn ? white : black;
-}
-
-// returns a copy of the player object
-Bot Chess::GetCurrentPlayerConst() const noexcept {
-	return whites_turn ? white : black;
-}
-
-// returns a reference to the player object
-Bot& Chess::GetOtherPlayer() noexcept {
-	return whites_turn ? black : white;
-}
-
-// returns a copy of the player object
-Bot Chess::GetOtherPlayerConst() const noexcept {
-	return whites_turn ? black : white;
-}
-
-// changes whose turn it is so the other player can make its move
-void Chess::ChangeTurn() noexcept {
-	whites_turn = !whites_turn;
-}
-
-// appends the last made game move to "all_game_moves" list
-void Chess::AppendToAllGameMoves(const short &x1, const short &y1, const short &x2, const short &y2) noexcept {
-	if(GetCurrentPlayerConst().GetCastling() && (board[y1][x1] == B_KING + 7*whites_turn) && (x2 == 2 || x2 == 6))
-		all_game_moves.emplace_back(CASTLING, std::string(1, x2));
-	else
-		all_game_moves.emplace_back(NORMAL, ToString(x1, y1, x2, y2) + board[y1][x1] + board[y2][x2]);
-}
-
-// resets the game, everything is back to its default value
-void Chess::Reset() noexcept {
-	CopyBoard(STARTING_BOARD, board);
-	white.Reset();
-	black.Reset();
-	all_game_moves.clear();
-	whites_turn = true;
-	moves_after_last_pawn_move_or_capture = 0;
-	system("cls");
-}
-
-// a function for exception handling, checks whether the given coordinates is within board boundaries or not
-void Chess::CheckCoordinates(const short &x, const short &y, const std::string &func_name) const noexcept(false) {
-	try {
-		if(!WithinBounds(x))		throw x;
-		if(!WithinBounds(y))		throw y;
-	}
-	catch(const short &coord) {
-		std::cerr << std::endl << std::endl << TO_RIGHT << "!ERROR!\t\tInvalid coordinate: '" << coord << "'.\t\t!ERROR!";
-		std::cerr << std::endl << TO_RIGHT << "      \t\tException occurred in \"" << func_name << "\".";
-		PrintAllMovesMadeInOrder();
-		exit(1);
-	}
-}
-
-// prints game over message to the terminal
-bool Chess::EndGameText(const unsigned short &n, const Endgame &end_game) const noexcept {
-	ClearAllMoves(n);
-	MoveCursorToXY(RIGHT, DOWN + 3*BOARD_SIZE + 7);
-	switch(end_game) {
-		case CHECKMATE:
-			std::cout << "!!!Checkmate!!!" << CLEAR_LINE << std::endl << TO_RIGHT << GetOtherPlayerConst().GetName() << " wins!";
-			return true;
-		default:
-			std::cout << "!!!Draw!!!" << CLEAR_LINE << std::endl << TO_RIGHT;
-			switch(end_game) {
-				case FIFTY_MOVES:
-					std::cout << "Fifty-move rule: No capture has been made and no pawn has been moved in the last 50 moves.";
-					return true;
-				case THREEFOLD_REP:
-					std::cout << "Threefold repetition: Last position occured 3 times during the game.";
-					return true;
-				default:
-					return false;
-			}
-	}
-}
-
-// returns the x coordinate of the eaten pawn piece
-short Chess::GetEnPassant(const short &x, const short &y) const noexcept {
-	if(all_game_moves.empty())
-		return -1;
-	if(all_game_moves.back().first != NORMAL)
-		return -1;
-	auto last_move = all_game_moves.back().second;
-	ChangeToRealCoordinates(last_move[0], last_move[1], last_move[2], last_move[3]);
-	return ((last_move[4] == W_PAWN - 7*whites_turn) && (abs(last_move[0] - x) == 1) && (last_move[3]-last_move[1] == 2*(whites_turn ? 1 : -1)) && (y == 4 - whites_turn)) ? last_move[0] : -1;
-}
-
-// returns the x coordinate of the en passant move
-template<class Iterator> short Chess::GetEnPassant(const char board[BOARD_SIZE][BOARD_SIZE], const Iterator &it) const noexcept {
-	if(it->first != NORMAL)
-		return -1;
-	auto last_move = it->second;
-	ChangeToRealCoordinates(last_move[0], last_move[1], last_move[2], last_move[3]);
-	for(short x=0;x<BOARD_SIZE;++x)
-		if(board[3 + whites_turn][x] == W_PAWN - 7*whites_turn)
-			if((last_move[4] == B_PAWN + 7*whites_turn) && (abs(last_move[0] - x) == 1) && (last_move[3] - last_move[1] == 2*(whites_turn ? -1 : 1)))
-				return last_move[0];
-	return -1;
-}
-
-// returns true if threefold repetition occurs, false otherwise
-bool Chess::ThreefoldRepetition() const noexcept {
-	static char prev_board[BOARD_SIZE][BOARD_SIZE];
-	CopyBoard(board, prev_board);
-	unsigned short position_count = 1;
-	auto it = all_game_moves.crbegin();
-	auto last_move = it->second;
-	while(true) {
-		for(unsigned short i=0;i<2;++i)	{
-			switch(it->first) {
-				case CASTLING:
-					return false;		// if a pawn has moved or a castling/capture has occured, then that board position is unique and repetition is not possible
-				default:
-					if(last_move[4] == W_PAWN || last_move[4] == B_PAWN || last_move[5] != EMPTY)
-						return false;
-					ChangeToRealCoordinates(last_move[0], last_move[1], last_move[2], last_move[3]);
-					prev_board[short(last_move[1])][short(last_move[0])] = last_move[4], prev_board[short(last_move[3])][short(last_move[2])] = EMPTY;
-					if(it->first == EN_PASSANT)
-						prev_board[short(last_move[1])][short(last_move[2])] = i == whites_turn ? B_PAWN : W_PAWN;
-			}
-			if((++it) == all_game_moves.crend())
-				return false;
-			last_move = it->second;
-		}
-		if(AreBoardsEqual(prev_board, board))		// check for castling and en passant in every 2 turns
-			if(GetOtherPlayerConst().GetCastling() == (it->first == CASTLING ? false : last_move[6 + (it->first == PROMOTION)]))
-				if((all_game_moves.size() > 1 ? GetEnPassant(board, prev(all_game_moves.cend(), 2)) : -1)
-				== (next(it) == all_game_moves.crend() ? -1 : GetEnPassant(prev_board, next(it))))
-					if((++position_count) == 3)
-						return true;
-	}
-}
-
-// returns true if the player's king is in check, false otherwise
-bool Chess::IsCheck(const bool &turn) const noexcept {
-	short x = -1, y = -1;
-	for(short i=0;x==-1;++i)
-		for(short j=0;j<BOARD_SIZE;++j)
-			if(board[j][i] == B_KING + 7*turn) {
-				x = i, y = j;
-				break;
-			}
-	for(short i=x+1;i<BOARD_SIZE;++i)						// check queen and rook
-		if(board[y][i] == W_ROOK - 7*turn)			return true;
-		else if(board[y][i] == W_QUEEN - 7*turn)	return true;
-		else if(board[y][i] != EMPTY)	break;
-	for(short i=x-1;i>=0;--i)
-		if(board[y][i] == W_ROOK - 7*turn)			return true;
-		else if(board[y][i] == W_QUEEN - 7*turn)	return true;
-		else if(board[y][i] != EMPTY)	break;
-	for(short i=y+1;i<BOARD_SIZE;++i)
-		if(board[i][x] == W_ROOK - 7*turn)			return true;
-		else if(board[i][x] == W_QUEEN - 7*turn)	return true;
-		else if(board[i][x] != EMPTY)	break;
-	for(short i=y-1;i>=0;--i)
-		if(board[i][x] == W_ROOK - 7*turn)			return true;
-		else if(board[i][x] == W_QUEEN - 7*turn)	return true;
-		else if(board[i][x] != EMPTY)	break;
-	for(short i=x-1, j=y-1; i>=0 && j>=0; --i, --j)			// check queen and bishop
-		if(board[j][i] == W_BISHOP - 7*turn)		return true;
-		else if(board[j][i] == W_QUEEN - 7*turn)	return true;
-		else if(board[j][i] != EMPTY)	break;
-	for(short i=x-1, j=y+1; i>=0 && j<BOARD_SIZE; --i, ++j)
-		if(board[j][i] == W_BISHOP - 7*turn)		return true;
-		else if(board[j][i] == W_QUEEN - 7*turn)	return true;
-		else if(board[j][i] != EMPTY)	break;
-	for(short i=x+1, j=y-1; i<BOARD_SIZE && j>=0; ++i, --j)
-		if(board[j][i] == W_BISHOP - 7*turn)		return true;
-		else if(board[j][i] == W_QUEEN - 7*turn)	return true;
-		else if(board[j][i] != EMPTY)	break;
-	for(short i=x+1, j=y+1; i<BOARD_SIZE && j<BOARD_SIZE; ++i, ++j)
-		if(board[j][i] == W_BISHOP - 7*turn)		return true;
-		else if(board[j][i] == W_QUEEN - 7*turn)	return true;
-		else if(board[j][i] != EMPTY)	break;
-	for(short i=x-1;i<x+2;++i)								// check king
-		for(short j=y-1;j<y+2;++j)
-			if((board[j][i] == W_KING - 7*turn) && WithinBounds(i) && WithinBounds(j))			return true;
-	if((board[y-1][x-2] == W_KNIGHT - 7*turn) && (y > 0) && (x > 1))							return true;	// check knight
-	else if((board[y-1][x+2] == W_KNIGHT - 7*turn) && (y > 0) && (x < BOARD_SIZE-2))			return true;
-	else if((board[y+1][x-2] == W_KNIGHT - 7*turn) && (y < BOARD_SIZE-1) && (x > 1))			return true;
-	else if((board[y+1][x+2] == W_KNIGHT - 7*turn) && (y < BOARD_SIZE-1) && (x < BOARD_SIZE-2))	return true;
-	else if((board[y-2][x-1] == W_KNIGHT - 7*turn) && (y > 1) && (x > 0))						return true;
-	else if((board[y-2][x+1] == W_KNIGHT - 7*turn) && (y > 1) && (x < BOARD_SIZE-1))			return true;
-	else if((board[y+2][x-1] == W_KNIGHT - 7*turn) && (y < BOARD_SIZE-2) && (x > 0))			return true;
-	else if((board[y+2][x+1] == W_KNIGHT - 7*turn) && (y < BOARD_SIZE-2) && (x < BOARD_SIZE-1))	return true;
-	else if((board[y + (turn ? -1 : 1)][x+1] == W_PAWN - 7*turn) && (x < BOARD_SIZE-1))			return true;	// check pawn
-	else if((board[y + (turn ? -1 : 1)][x-1] == W_PAWN - 7*turn) && (x > 0))					return true;
-	return false;
-}
-
-// function overload, returns true if the player's king is in check, false otherwise
-bool Chess::IsCheck(std::string &move) noexcept {
-	ChangeToRealCoordinates(move[0], move[1], move[2], move[3]);
-	MovePiece(move[0], move[1], move[2], move[3], false, false);
-	const bool &is_check = IsCheck(!whites_turn);
-	MovePieceBack(move[0], move[1], move[2], move[3]);
-	ChangeToString(move[0], move[1], move[2], move[3]);
-	return is_check;
-}
-
-// returns a list of all possible moves the pawn located in (x, y) can make
-std::forward_list<std::string> Chess::PawnMoves(const short &x, const short &y) const noexcept {
-	const auto &IsValid = whites_turn ? [](const char &ch){ return ch < 0; } : [](const char &ch){ return ch > 0; };
-	const short &inc = whites_turn ? -1 : 1;
-	std::forward_list<std::string> all_moves;
-	if(board[y+inc][x] == EMPTY) {
-		all_moves.emplace_front(ToString(x, y, x, y+inc));				// 1 square forward
-		if((y == 1 + 5*whites_turn) && (board[y + 2*inc][x] == EMPTY))
-			all_moves.emplace_front(ToString(x, y, x, y + 2*inc));		// 2 squares forward
-	}
-	if(GetEnPassant(x, y) != -1)
-		all_moves.emplace_front(ToString(x, y, GetEnPassant(x, y), y+inc));
-	if(IsValid(board[y+inc][x+1]) && (x < BOARD_SIZE-1))
-		all_moves.emplace_front(ToString(x, y, x+1, y+inc));		// diagonal attack moves
-	if(IsValid(board[y+inc][x-1]) && (x > 0))
-		all_moves.emplace_front(ToString(x, y, x-1, y+inc));
-	return all_moves;
-}
-
-// returns a list of all possible moves the rook located in (x, y) can make
-std::forward_list<std::string> Chess::RookMoves(const short &x, const short &y) const noexcept {
-	const auto &IsValid = whites_turn ? [](const char &ch){ return ch < 0; } : [](const char &ch){ return ch > 0; };
-	std::forward_list<std::string> all_moves;
-	for(short i=x+1;i<BOARD_SIZE;++i)			// right
-		if(board[y][i] == EMPTY)
-			all_moves.emplace_front(ToString(x, y, i, y));
-		else {
-			if(IsValid(board[y][i]))
-				all_moves.emplace_front(ToString(x, y, i, y));
-			break;
-		}
-	for(short i=x-1;i>=0;--i)					// left
-		if(board[y][i] == EMPTY)
-			all_moves.emplace_front(ToString(x, y, i, y));
-		else {
-			if(IsValid(board[y][i]))
-				all_moves.emplace_front(ToString(x, y, i, y));
-			break;
-		}
-	for(short i=y+1;i<BOARD_SIZE;++i)			// down
-		if(board[i][x] == EMPTY)
-			all_moves.emplace_front(ToString(x, y, x, i));
-		else {
-			if(IsValid(board[i][x]))
-				all_moves.emplace_front(ToString(x, y, x, i));
-			break;
-		}
-	for(short i=y-1;i>=0;--i)					// up
-		if(board[i][x] == EMPTY)
-			all_moves.emplace_front(ToString(x, y, x, i));
-		else {
-			if(IsValid(board[i][x]))
-				all_moves.emplace_front(ToString(x, y, x, i));
-			break;
-		}
-	return all_moves;
-}
-
-// returns a list of all possible moves the knight located in (x, y) can make
-std::forward_list<std::string> Chess::KnightMoves(const short &x, const short &y) const noexcept {
-	const auto &IsValid = whites_turn ? [](const char &ch){ return ch <= 0; } : [](const char &ch){ return ch >= 0; };
-	std::forward_list<std::string> all_moves;
-	if(IsValid(board[y-1][x-2]) && (y > 0) && (x > 1))
-		all_moves.emplace_front(ToString(x, y, x-2, y-1));
-	if(IsValid(board[y-1][x+2]) && (y > 0) && (x < BOARD_SIZE-2))
-		all_moves.emplace_front(ToString(x, y, x+2, y-1));
-	if(IsValid(board[y+1][x-2]) && (y < BOARD_SIZE-1) && (x > 1))
-		all_moves.emplace_front(ToString(x, y, x-2, y+1));
-	if(IsValid(board[y+1][x+2]) && (y < BOARD_SIZE-1) && (x < BOARD_SIZE-2))
-		all_moves.emplace_front(ToString(x, y, x+2, y+1));
-	if(IsValid(board[y-2][x-1]) && (y > 1) && (x > 0))
-		all_moves.emplace_front(ToString(x, y, x-1, y-2));
-	if(IsValid(board[y-2][x+1]) && (y > 1) && (x < BOARD_SIZE-1))
-		all_moves.emplace_front(ToString(x, y, x+1, y-2));
-	if(IsValid(board[y+2][x-1]) && (y < BOARD_SIZE-2) && (x > 0))
-		all_moves.emplace_front(ToString(x, y, x-1, y+2));
-	if(IsValid(board[y+2][x+1]) && (y < BOARD_SIZE-2) && (x < BOARD_SIZE-1))
-		all_moves.emplace_front(ToString(x, y, x+1, y+2));
-	return all_moves;
-}
-
-// returns a list of all possible moves the bishop located in (x, y) can make
-std::forward_list<std::string> Chess::BishopMoves(const short &x, const short &y) const noexcept {
-	const auto &IsValid = whites_turn ? [](const char &ch){ return ch < 0; } : [](const char &ch){ return ch > 0; };
-	std::forward_list<std::string> all_moves;
-	for(short i=x-1, j=y-1; i>=0 && j>=0; --i, --j)						// upper left diagonal
-		if(board[j][i] == EMPTY)
-			all_moves.emplace_front(ToString(x, y, i, j));
-		else {
-			if(IsValid(board[j][i]))
-				all_moves.emplace_front(ToString(x, y, i, j));
-			break;
-		}
-	for(short i=x-1, j=y+1; i>=0 && j<BOARD_SIZE; --i, ++j)				// lower left diagonal
-		if(board[j][i] == EMPTY)
-			all_moves.emplace_front(ToString(x, y, i, j));
-		else {
-			if(IsValid(board[j][i]))
-				all_moves.emplace_front(ToString(x, y, i, j));
-			break;
-		}
-	for(short i=x+1, j=y-1; i<BOARD_SIZE && j>=0; ++i, --j)				// upper right diagonal
-		if(board[j][i] == EMPTY)
-			all_moves.emplace_front(ToString(x, y, i, j));
-		else {
-			if(IsValid(board[j][i]))
-				all_moves.emplace_front(ToString(x, y, i, j));
-			break;
-		}
-	for(short i=x+1, j=y+1; i<BOARD_SIZE && j<BOARD_SIZE; ++i, ++j)		// lower right diagonal
-		if(board[j][i] == EMPTY)
-			all_moves.emplace_front(ToString(x, y, i, j));
-		else {
-			if(IsValid(board[j][i]))
-				all_moves.emplace_front(ToString(x, y, i, j));
-			break;
-		}
-	return all_moves;
-}
-
-// returns a list of all possible moves the queen located in (x, y) can make
-std::forward_list<std::string> Chess::QueenMoves(const short &x, const short &y) const noexcept {
-	auto all_moves = RookMoves(x, y);			// queen = rook + bishop
-	all_moves.merge(BishopMoves(x, y));
-	return all_moves;
-}
-
-// returns a list of all possible moves the king located in (x, y) can make
-std::forward_list<std::string> Chess::KingMoves(const short &x, const short &y) const noexcept {
-	const auto &IsValid = whites_turn ? [](const char &ch){ return ch <= 0; } : [](const char &ch){ return ch >= 0; };
-	std::forward_list<std::string> all_moves;
-	for(short i=x-1;i<x+2;++i)		// add moves within 1 square reach
-		for(short j=y-1;j<y+2;++j)
-			if(IsValid(board[j][i]) && WithinBounds(i) && WithinBounds(j))
-				all_moves.emplace_front(ToString(x, y, i, j));
-	if(GetCurrentPlayerConst().GetCastling())		// add castling moves if castling is possible
-		if(!IsCheck(whites_turn)) {
-			const short &line = (BOARD_SIZE-1)*whites_turn;
-			if((board[line][0] == B_ROOK + 7*whites_turn) && board[line][1] == EMPTY && board[line][2] == EMPTY && board[line][3] == EMPTY)
-				all_moves.emplace_front(ToString(4, line, 2, line));	// long castling
-			else if((board[line][7] == B_ROOK + 7*whites_turn) && board[line][5] == EMPTY && board[line][6] == EMPTY)
-				all_moves.emplace_front(ToString(4, line, 6, line));	// short castling
-		}
-	return all_moves;
-}
-
-// returns a list of all possible moves the player can make
-std::forward_list<std::string> Chess::AllMoves() noexcept {
-	std::forward_list<std::string> all_moves;
-	for(short y=0;y<BOARD_SIZE;++y)
-		for(short x=0;x<BOARD_SIZE;++x) {
-			if((board[y][x] < 0) == whites_turn)
-				continue;
-			switch(board[y][x]) {
-				case W_PAWN:
-				case B_PAWN:
-					all_moves.merge(PawnMoves(x, y));
-					break;
-				case W_ROOK:
-				case B_ROOK:
-					all_moves.merge(RookMoves(x, y));
-					break;
-				case W_KNIGHT:
-				case B_KNIGHT:
-					all_moves.merge(KnightMoves(x, y));
-					break;
-				case W_BISHOP:
-				case B_BISHOP:
-					all_moves.merge(BishopMoves(x, y));
-					break;
-				case W_QUEEN:
-				case B_QUEEN:
-					all_moves.merge(QueenMoves(x, y));
-					break;
-				case W_KING:
-				case B_KING:
-					all_moves.merge(KingMoves(x, y));
-			}
-		}
-	for(auto it = all_moves.begin(), prev = all_moves.before_begin(); it != all_moves.cend();)		// if the possible move makes me checkmate after the opponent's turn, remove it from the list
-		if(IsCheck(*it))
-			it = all_moves.erase_after(prev);
-		else
-			++it, ++prev;
-	return all_moves;
-}
-
-// returns a random move the player can make
-std::string Chess::GetRandomMove() noexcept {
-	auto all_moves = AllMoves();
-	auto move = all_moves.begin();
-	advance(move, GetRandomNumber<unsigned short>(0, distance(all_moves.cbegin(), all_moves.cend()) - 1));
-	ChangeToRealCoordinates((*move)[0], (*move)[1], (*move)[2], (*move)[3]);
-	return *move;
-}
-
-// asks the player it's choice of promotion, then promotes the pawn to the desired piece
-void Chess::ManuallyPromotePawn(const short &x, const short &y) noexcept {
-	MoveCursorToXY(RIGHT, DOWN + 3*BOARD_SIZE + 7);
-	std::cout << "Enter your choice of promotion [(r)ook, (k)night, (b)ishop, (q)ueen]";
-	char key = getch();
-	while(true)
-		switch(key = tolower(key)) {
-			case 'r':	board[y][x] = whites_turn ? W_ROOK : B_ROOK;		return;
-			case 'k':	board[y][x] = whites_turn ? W_KNIGHT : B_KNIGHT;	return;
-			case 'b':	board[y][x] = whites_turn ? W_BISHOP : B_BISHOP;	return;
-			case 'q':	board[y][x] = whites_turn ? W_QUEEN : B_QUEEN;		return;
-			default:	key = getch();
-		}
-}
-
-// moves the piece from (x1, y1) to (x2, y2)
-void Chess::MovePiece(const short &x1, const short &y1, const short &x2, const short &y2, const bool &manual_promotion, const bool &update_board) noexcept {
-//	CheckCoordinates(x1, y1, "MovePiece");
-//	CheckCoordinates(x2, y2, "MovePiece");
-	AppendToAllGameMoves(x1, y1, x2, y2);		// similar to FEN notation but not really, the starting and ending points of the moving piece, promoted piece if there is promotion and ability to do castling
-	switch(board[y1][x1]) {
-		case W_PAWN:
-		case B_PAWN:
-			if(y2 == ((BOARD_SIZE-1) * !whites_turn)) {			// check for castling, promotion or en passant
-				if(manual_promotion) {
-					ManuallyPromotePawn(x1, y1);
-					MoveCursorToXY(RIGHT, DOWN + 3*BOARD_SIZE + 7);
-					std::cout << "All possible moves:" << CLEAR_LINE;
-				}
-				else if(whites_turn ? WHITE_BOT_RANDOM : BLACK_BOT_RANDOM)
-					board[y1][x1] = (whites_turn ? 1 : -1) * GetRandomNumber(2, 5);
-				else
-					board[y1][x1] = whites_turn ? W_QUEEN : B_QUEEN;
-				all_game_moves.back().first = PROMOTION;
-				all_game_moves.back().second.push_back(board[y1][x1]);
-			}
-			else if(x1 != x2 && board[y2][x2] == EMPTY) {
-				board[y1][x2] = EMPTY;
-				if(update_board) {
-					GetCurrentPlayer().IncreaseScore(EvaluatePiece(W_PAWN));
-					UpdateScore(GetCurrentPlayerConst());
-					UpdateBoard(x2, y1);
-				}
-				all_game_moves.back().first = EN_PASSANT;
-			}
-			break;
-		case W_KING:
-		case B_KING:
-			if(GetCurrentPlayerConst().GetCastling()) {
-				const short &line = (BOARD_SIZE-1) * whites_turn;
-				switch(x2) {
-					case 2:
-						board[line][3] = board[line][0], board[line][0] = EMPTY;
-						if(update_board) {
-							UpdateBoard(0, line);
-							UpdateBoard(3, line);
-						}
-						break;
-					case 6:
-						board[line][5] = board[line][7], board[line][7] = EMPTY;
-						if(update_board) {
-							UpdateBoard(7, line);
-							UpdateBoard(5, line);
-						}
-				}
-			}
-		case W_ROOK:
-		case B_ROOK:
-			GetCurrentPlayer().SetCastling(false);
-	}
-	if(all_game_moves.back().first != CASTLING)				all_game_moves.back().second.push_back(GetCurrentPlayerConst().GetCastling());
-	board[y2][x2] = board[y1][x1], board[y1][x1] = EMPTY;
-	if(update_board) {
-		if(all_game_moves.back().first != CASTLING)
-			if(all_game_moves.back().second[5] != EMPTY) {
-				GetCurrentPlayer().IncreaseScore(EvaluatePiece(all_game_moves.back().second[5]));
-				UpdateScore(GetCurrentPlayerConst());
-				moves_after_last_pawn_move_or_capture = 0;		// the piece is eaten
-			}
-		UpdateBoard(x1, y1);
-		UpdateBoard(x2, y2);
-	}
-	ChangeTurn();		// it's the opponent's turn
-}
-
-// undoes the move from (x1,y1) to (x2,y2), the opposite of the "MovePiece" function
-void Chess::MovePieceBack(const short &x1, const short &y1, const short &x2, const short &y2) noexcept {
-	ChangeTurn();
-	board[y1][x1] = board[y2][x2], board[y2][x2] = all_game_moves.back().first == CASTLING ? static_cast<char>(EMPTY) : all_game_moves.back().second[5];
-	switch(board[y1][x1]) {
-		case W_PAWN:
-		case B_PAWN:
-			if(x1 != x2 && board[y2][x2] == EMPTY)
-				board[y1][x2] = whites_turn ? B_PAWN : W_PAWN;
-			break;
-		case W_ROOK:
-		case B_ROOK:
-			if(prev(all_game_moves.cend(), 3)->first != CASTLING)
-				if(prev(all_game_moves.cend(), 3)->second[6 + (prev(all_game_moves.cend(), 3)->first == PROMOTION)])
-					GetCurrentPlayer().SetCastling(true);
-			break;
-		case W_QUEEN:
-		case B_QUEEN:
-			if(all_game_moves.back().first == PROMOTION)
-				board[y1][x1] = whites_turn ? W_PAWN : B_PAWN;
-			break;
-		case W_KING:
-		case B_KING:
-			if(all_game_moves.back().first == CASTLING) {
-				GetCurrentPlayer().SetCastling(true);
-				const short line = (BOARD_SIZE-1) * whites_turn;
-				switch(x2) {
-					case 2:
-						board[line][0] = board[line][3], board[line][3] = EMPTY;
-						break;
-					case 6:
-						board[line][7] = board[line][5], board[line][5] = EMPTY;
-				}
-			}
-			else if(prev(all_game_moves.cend(), 3)->first != CASTLING)
-				if(prev(all_game_moves.cend(), 3)->second[6 + (prev(all_game_moves.cend(), 3)->first == PROMOTION)])
-					GetCurrentPlayer().SetCastling(true);
-	}
-	all_game_moves.pop_back();
-}
-
-// updates the board display on the terminal
-void Chess::UpdateBoard(const short &x, const short &y) const noexcept {
-	const unsigned short &diff = BOX_WIDTH - PieceNameToString(board[y][x]).length();
-	MoveCursorToXY(RIGHT + (BOX_WIDTH+1)*x, DOWN + 3*y + 1);
-	std::cout << std::string(diff/2, ' ') << PieceNameToString(board[y][x]) << std::string(diff/2, ' ');
-	if(diff%2)	std::cout << " ";
-}
-
-// updates the score display on the terminal
-void Chess::UpdateScore(const Bot &p) const noexcept {
-	const unsigned short &dx = p==white ? white.GetName().length() + 2 : (BOX_WIDTH+1)*BOARD_SIZE - 5;
-	MoveCursorToXY(RIGHT+dx, DOWN + 3*BOARD_SIZE + 2);
-	std::cout << std::string(std::to_string(p.GetScore()).length(), ' ');
-	MoveCursorToXY(RIGHT+dx, DOWN + 3*BOARD_SIZE + 2);
-	std::cout << p.GetScore();
-}
-
-// returns the worth of the position of the piece in terms of points
-float Chess::EvaluatePosition(const short &x, const short &y) const noexcept {
-	if(board[y][x] == EMPTY)
-		return 0;
-	static float PIECE_POS_POINTS[6][BOARD_SIZE][BOARD_SIZE] =
-	{{{-3.0, -4.0, -4.0, -5.0, -5.0, -4.0, -4.0, -3.0},		// king
-	{-3.0, -4.0, -4.0, -5.0, -5.0, -4.0, -4.0, -3.0},
-	{-3.0, -4.0, -4.0, -5.0, -5.0, -4.0, -4.0, -3.0},
-	{-3.0, -4.0, -4.0, -5.0, -5.0, -4.0, -4.0, -3.0},
-	{-2.0, -3.0, -3.0, -4.0, -4.0, -3.0, -3.0, -2.0},
-	{-1.0, -2.0, -2.0, -2.0, -2.0, -2.0, -2.0, -1.0},
-	{2.0, 2.0, 0.0, 0.0, 0.0, 0.0, 2.0, 2.0},
-	{2.0, 3.0, 1.0, 0.0, 0.0, 1.0, 3.0, 2.0}}
-	,
-	{{-2.0, -1.0, -1.0, -0.5, -0.5, -1.0, -1.0, -2.0},		// queen
-	{-1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, -1.0},
-	{-1.0, 0.0, 0.5, 0.5, 0.5, 0.5, 0.0, -1.0},
-	{-0.5, 0.0, 0.5, 0.5, 0.5, 0.5, 0.0, -0.5},
-	{0.0, 0.0, 0.5, 0.5, 0.5, 0.5, 0.0, -0.5},
-	{-1.0, 0.5, 0.5, 0.5, 0.5, 0.5, 0.0, -1.0},
-	{-1.0, 0.0, 0.5, 0.0, 0.0, 0.0, 0.0, -1.0},
-	{-2.0, -1.0, -1.0, -0.5, -0.5, -1.0, -1.0, -2.0}}
-	,
-	{{-2.0, -1.0, -1.0, -1.0, -1.0, -1.0, -1.0, -2.0},		// bishop
-	{-1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, -1.0},
-	{-1.0, 0.0, 0.5, 1.0, 1.0, 0.5, 0.0, -1.0},
-	{-1.0, 0.5, 0.5, 1.0, 1.0, 0.5, 0.5, -1.0},
-	{-1.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, -1.0},
-	{-1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, -1.0},
-	{-1.0, 0.5, 0.0, 0.0, 0.0, 0.0, 0.5, -1.0},
-	{-2.0, -1.0, -1.0, -1.0, -1.0, -1.0, -1.0, -2.0}}
-	,
-	{{-5.0, -4.0, -3.0, -3.0, -3.0, -3.0, -4.0, -5.0},		// knight
-	{-4.0, -2.0, 0.0, 0.0, 0.0, 0.0, -2.0, -4.0},
-	{-3.0, 0.0, 1.0, 1.5, 1.5, 1.0, 0.0, -3.0},
-	{-3.0, 0.5, 1.5, 2.0, 2.0, 1.5, 0.5, -3.0},
-	{-3.0, 0.0, 1.5, 2.0, 2.0, 1.5, 0.0, -3.0},
-	{-3.0, 0.5, 1.0, 1.5, 1.5, 1.0, 0.5, -3.0},
-	{-4.0, -2.0, 0.0, 0.5, 0.5, 0.0, -2.0, -4.0},
-	{-5.0, -4.0, -3.0, -3.0, -3.0, -3.0, -4.0, -5.0}}
-	,
-	{{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},				// rook
-	{0.5, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.5},
-	{-0.5, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, -0.5},
-	{-0.5, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, -0.5},
-	{-0.5, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, -0.5},
-	{-0.5, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, -0.5},
-	{-0.5, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, -0.5},
-	{0.0, 0.0, 0.0, 0.5, 0.5, 0.0, 0.0, 0.0}}
-	,
-	{{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},				// pawn
-	{5.0, 5.0, 5.0, 5.0, 5.0, 5.0, 5.0, 5.0},
-	{1.0, 1.0, 2.0, 3.0, 3.0, 2.0, 1.0, 1.0},
-	{0.5, 0.5, 1.0, 2.5, 2.5, 1.0, 0.5, 0.5},
-	{0.0, 0.0, 0.0, 2.0, 2.0, 0.0, 0.0, 0.0},
-	{0.5, -0.5, -1.0, 0.0, 0.0, -1.0, -0.5, 0.5},
-	{0.5, 1.0, 1.0, -2.0, -2.0, 1.0, 1.0, 0.5},
-	{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}}};				// returns negative points if the pieces are black, positive points if the pieces are white
-	return (board[y][x]<0 ? -1 : 1) * (EvaluatePiece(board[y][x]) + PIECE_POS_POINTS[board[y][x] + 7*(board[y][x]<0) - 1][board[y][x]<0 ? BOARD_SIZE-y-1 : y][x]);
-}
-
-// returns the worth of the board position in terms of points
-float Chess::EvaluateBoard(const bool &turn) const noexcept {
-	float total_evaluation = 0.0;
-	for(short y=0;y<BOARD_SIZE;++y)
-		for(short x=0;x<BOARD_SIZE;++x)
-			total_evaluation += EvaluatePosition(x, y);
-	return (turn ? 1 : -1) * total_evaluation;
-}
-
-// prints the game board on the terminal
-void Chess::PrintBoard() const noexcept {
-	std::cout << TO_DOWN << TO_RIGHT;
-	for(short y=0;y<BOARD_SIZE;++y) {
-		PrintSeparator(' ');
-		std::cout << "\b\b\b" << BOARD_SIZE-y << "  ";
-		for(short x=0;x<BOARD_SIZE;++x) {
-			const unsigned short &diff = BOX_WIDTH - PieceNameToString(board[y][x]).length();
-			std::cout << std::string(diff/2, ' ') << PieceNameToString(board[y][x]) << std::string(diff/2, ' ');
-			if(diff%2)				std::cout << " ";
-			if(x < BOARD_SIZE-1)	std::cout << "|";
-		}
-		if(y < BOARD_SIZE-1) {
-			std::cout << std::endl << TO_RIGHT;
-			PrintSeparator('_');
-		}
-	}
-	std::cout << std::endl << TO_RIGHT;
-	PrintSeparator(' ');
-	for(char ch='a';ch<'a'+BOARD_SIZE;++ch)
-		std::cout << std::string(BOX_WIDTH/2, ' ') << ch << std::string(BOX_WIDTH/2, ' ');
-	std::cout << std::endl << std::endl << TO_RIGHT << white.GetName() << ": 0";
-	std::cout << std::string((BOX_WIDTH+1)*BOARD_SIZE - white.GetName().length() - black.GetName().length() - 10, ' ') << black.GetName() << ": 0";
-	std::cout << std::endl << std::endl << TO_RIGHT << white.GetName() << "'s turn...";
-	std::cout << std::endl << TO_RIGHT << "Enter move coordinates (x1,y1)->(x2,y2):";
-	std::cout << std::endl << std::endl << TO_RIGHT << "All possible moves:" << std::endl;
-}
-
-// after the game is over, prints all moves played throughout the game in chronological order
-void Chess::PrintAllMovesMadeInOrder() const noexcept {
-	std::cout << std::endl << std::endl << TO_RIGHT << "All moves made in order:" << std::endl;
-	bool turn = true;
-	for(const auto &game_move : all_game_moves) {
-		std::cout << std::endl << TO_RIGHT << (turn ? white : black).GetName() << ": ";
-		switch(game_move.first) {
-			case CASTLING:
-				std::cout << "castling " << (game_move.second[0] == 2 ? "long" : "short");	break;
-			default:
-				std::cout << ToLowerString(PieceNameToString(game_move.second[4])).substr(2) << " '" << game_move.second.substr(0, 2) << "' to ";
-				if(game_move.second[5] != EMPTY)
-					std::cout << ToLowerString(PieceNameToString(game_move.second[5])).substr(2) + " ";
-				std::cout << "'" << game_move.second.substr(2, 2) << "'";
-				switch(game_move.first) {
-					case PROMOTION:
-						std::cout << " promoted to " << ToLowerString(PieceNameToString(game_move.second[6])).substr(2);
-						break;
-					case EN_PASSANT:
-						std::cout << " (en passant)";
-					default:
-						break;
-				}
-		}
-		turn = !turn;
-	}
-}
-
-// checks if the game is over or not
-bool Chess::CheckEndgame(const unsigned short &n) noexcept {
-	if(AllMoves().empty()) {			// if the opponent has no moves left, then it is checkmate
-		GetOtherPlayer().IncreaseScore(EvaluatePiece(W_KING));
-		UpdateScore(GetOtherPlayerConst());
-		return EndGameText(n, CHECKMATE);
-	}
-	else if(all_game_moves.back().first != CASTLING) {
-		if(all_game_moves.back().second[4] == W_PAWN - 7*whites_turn)
-			moves_after_last_pawn_move_or_capture = 0;		// pawn has moved
-		else if(all_game_moves.back().second[5] != EMPTY)
-			moves_after_last_pawn_move_or_capture = 0;		// capture has occured
-		else if((++moves_after_last_pawn_move_or_capture) == 50)
-			return EndGameText(n, FIFTY_MOVES);
-	}
-	else if((++moves_after_last_pawn_move_or_capture) == 50)
-		return EndGameText(n, FIFTY_MOVES);
-	if(ThreefoldRepetition())
-		return EndGameText(n, THREEFOLD_REP);
-	return false;
-}
-
-// lists all possible moves, expects player input and plays the given move if it is valid, expects a valid input otherwise
-bool Chess::PlayersTurn() noexcept {
-	auto all_moves = AllMoves();
-	all_moves.sort();
-	unsigned short i=0;
-	for(const auto &move : all_moves) {
-		if(!((i++)%MOVES_PER_LINE))	std::cout << std::endl;
-		std::cout << TO_RIGHT << move.substr(0, 2) << " " << move.substr(2);
-	}
-	if(IsCheck(whites_turn)) {
-		std::cout << std::endl << std::endl << TO_RIGHT << "Check!";
-		i += 2*MOVES_PER_LINE;
-	}
-	MoveCursorToXY(RIGHT+41, DOWN + 3*BOARD_SIZE + 5);
-	while(true) {
-		std::string from, to;
-		std::cin >> from;
-		if(!ToLowerString(from).compare("quit"))
-			return EndGameText(i/MOVES_PER_LINE + 1, QUIT);
-		if(!ToLowerString(from).compare("exit"))
-			return EndGameText(i/MOVES_PER_LINE + 1, QUIT);
-		std::cin >> to;
-		from.resize(2);
-		to.resize(2);
-		from.shrink_to_fit();
-		to.shrink_to_fit();
-		from[0] = tolower(from[0]), to[0] = tolower(to[0]);
-		ChangeToRealCoordinates(from[0], from[1], to[0], to[1]);
-		if((from[0]!=to[0] || from[1]!=to[1]) && WithinBounds(from[0]) && WithinBounds(from[1]) && WithinBounds(to[0]) && WithinBounds(to[1]))
-			if(CanMovePiece(from[0], from[1], to[0], to[1], all_moves)) {
-				MovePiece(from[0], from[1], to[0], to[1], true, true);
-				if(CheckEndgame(i/MOVES_PER_LINE + 1))
-					return false;
-				break;
-			}
-		MoveCursorToXY(RIGHT+41, DOWN + 3*BOARD_SIZE + 5);
-		std::cout << CLEAR_LINE << std::endl << CLEAR_LINE;
-		MoveCursorToXY(RIGHT+41, DOWN + 3*BOARD_SIZE + 5);
-	}
-	MoveCursorToXY(RIGHT, DOWN + 3*BOARD_SIZE + 4);
-	std::cout << GetCurrentPlayerConst().GetName() << "'s turn..." << CLEAR_LINE;
-	MoveCursorToXY(RIGHT+41, DOWN + 3*BOARD_SIZE + 5);
-	std::cout << CLEAR_LINE << std::endl << CLEAR_LINE;
-	ClearAllMoves(i/MOVES_PER_LINE + 1);
-	MoveCursorToXY(0, DOWN + 3*BOARD_SIZE + 8);
-	return true;
-}
-
-// plays the bots move
-bool Chess::BotsTurn() noexcept {
-	const auto &move = (whites_turn ? WHITE_BOT_RANDOM : BLACK_BOT_RANDOM) ? GetRandomMove() : GetCurrentPlayer().GetIdealMove(*this);
-	MovePiece(move[0], move[1], move[2], move[3], false, true);
-	if(CheckEndgame())
-		return false;
-	MoveCursorToXY(RIGHT, DOWN + 3*BOARD_SIZE + 4);
-	std::cout << GetCurrentPlayerConst().GetName() << "'s turn..." << CLEAR_LINE;
-	return true;
-}
-
-// prints game over messages and expects user input for another game
-bool Chess::GameOver() noexcept {
-	std::cout << std::endl << std::endl << std::endl << TO_RIGHT << "Press R to play again.";
-	std::cout << std::endl << TO_RIGHT << "Press any other key to quit.";
-	PrintAllMovesMadeInOrder();
-	char key = getch();
-	switch(key = tolower(key)) {
-		case 'r':
-			Reset();
-			return true;
-		default:
-			return false;
-	}
-}
+#include "chess.h"
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <sstream>
+
+// function definitions
+
+#if COUNT_ALLOCATIONS
+#include <new>
+
+static thread_local unsigned long long allocation_count = 0;		// each thread counts its own allocations, so other threads cannot disturb a check
+
+// replaces the global allocation function so that every heap allocation is counted by the thread that makes it
+void* operator new(std::size_t size) {
+	++allocation_count;
+	if(void *ptr = malloc(size ? size : 1))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+// the matching deallocation function of the replaced allocation function
+void operator delete(void *ptr) noexcept {
+	free(ptr);
+}
+#endif
+
+// returns the number of heap allocations the calling thread made so far, always zero unless COUNT_ALLOCATIONS is true
+unsigned long long GetAllocationCount() noexcept {
+#if COUNT_ALLOCATIONS
+	return allocation_count;
+#else
+	return 0;
+#endif
+}
+
+// returns the given string in lowercase
+std::string ToLowerString(std::string s) noexcept {
+	transform(s.begin(), s.end(), s.begin(), [](const unsigned char &c){ return tolower(c); });
+	return s;
+}
+
+
+
+// evaluation tables
+
+// worth of the position of each piece type in terms of points, from team white's point of view
+static const float PIECE_POS_POINTS[6][BOARD_SIZE][BOARD_SIZE] =
+{{{-3.0, -4.0, -4.0, -5.0, -5.0, -4.0, -4.0, -3.0},		// king
+{-3.0, -4.0, -4.0, -5.0, -5.0, -4.0, -4.0, -3.0},
+{-3.0, -4.0, -4.0, -5.0, -5.0, -4.0, -4.0, -3.0},
+{-3.0, -4.0, -4.0, -5.0, -5.0, -4.0, -4.0, -3.0},
+{-2.0, -3.0, -3.0, -4.0, -4.0, -3.0, -3.0, -2.0},
+{-1.0, -2.0, -2.0, -2.0, -2.0, -2.0, -2.0, -1.0},
+{2.0, 2.0, 0.0, 0.0, 0.0, 0.0, 2.0, 2.0},
+{2.0, 3.0, 1.0, 0.0, 0.0, 1.0, 3.0, 2.0}}
+,
+{{-2.0, -1.0, -1.0, -0.5, -0.5, -1.0, -1.0, -2.0},		// queen
+{-1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, -1.0},
+{-1.0, 0.0, 0.5, 0.5, 0.5, 0.5, 0.0, -1.0},
+{-0.5, 0.0, 0.5, 0.5, 0.5, 0.5, 0.0, -0.5},
+{0.0, 0.0, 0.5, 0.5, 0.5, 0.5, 0.0, -0.5},
+{-1.0, 0.5, 0.5, 0.5, 0.5, 0.5, 0.0, -1.0},
+{-1.0, 0.0, 0.5, 0.0, 0.0, 0.0, 0.0, -1.0},
+{-2.0, -1.0, -1.0, -0.5, -0.5, -1.0, -1.0, -2.0}}
+,
+{{-2.0, -1.0, -1.0, -1.0, -1.0, -1.0, -1.0, -2.0},		// bishop
+{-1.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, -1.0},
+{-1.0, 0.0, 0.5, 1.0, 1.0, 0.5, 0.0, -1.0},
+{-1.0, 0.5, 0.5, 1.0, 1.0, 0.5, 0.5, -1.0},
+{-1.0, 0.0, 1.0, 1.0, 1.0, 1.0, 0.0, -1.0},
+{-1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, -1.0},
+{-1.0, 0.5, 0.0, 0.0, 0.0, 0.0, 0.5, -1.0},
+{-2.0, -1.0, -1.0, -1.0, -1.0, -1.0, -1.0, -2.0}}
+,
+{{-5.0, -4.0, -3.0, -3.0, -3.0, -3.0, -4.0, -5.0},		// knight
+{-4.0, -2.0, 0.0, 0.0, 0.0, 0.0, -2.0, -4.0},
+{-3.0, 0.0, 1.0, 1.5, 1.5, 1.0, 0.0, -3.0},
+{-3.0, 0.5, 1.5, 2.0, 2.0, 1.5, 0.5, -3.0},
+{-3.0, 0.0, 1.5, 2.0, 2.0, 1.5, 0.0, -3.0},
+{-3.0, 0.5, 1.0, 1.5, 1.5, 1.0, 0.5, -3.0},
+{-4.0, -2.0, 0.0, 0.5, 0.5, 0.0, -2.0, -4.0},
+{-5.0, -4.0, -3.0, -3.0, -3.0, -3.0, -4.0, -5.0}}
+,
+{{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},				// rook
+{0.5, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 0.5},
+{-0.5, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, -0.5},
+{-0.5, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, -0.5},
+{-0.5, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, -0.5},
+{-0.5, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, -0.5},
+{-0.5, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, -0.5},
+{0.0, 0.0, 0.0, 0.5, 0.5, 0.0, 0.0, 0.0}}
+,
+{{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0},				// pawn
+{5.0, 5.0, 5.0, 5.0, 5.0, 5.0, 5.0, 5.0},
+{1.0, 1.0, 2.0, 3.0, 3.0, 2.0, 1.0, 1.0},
+{0.5, 0.5, 1.0, 2.5, 2.5, 1.0, 0.5, 0.5},
+{0.0, 0.0, 0.0, 2.0, 2.0, 0.0, 0.0, 0.0},
+{0.5, -0.5, -1.0, 0.0, 0.0, -1.0, -0.5, 0.5},
+{0.5, 1.0, 1.0, -2.0, -2.0, 1.0, 1.0, 0.5},
+{0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0}}};
+
+// worth of the position of the king once most pieces are traded, from team white's point of view, the king should head for the center
+static const float KING_ENDGAME_POS_POINTS[BOARD_SIZE][BOARD_SIZE] =
+{{-5.0, -4.0, -3.0, -2.0, -2.0, -3.0, -4.0, -5.0},
+{-3.0, -2.0, -1.0, 0.0, 0.0, -1.0, -2.0, -3.0},
+{-3.0, -1.0, 2.0, 3.0, 3.0, 2.0, -1.0, -3.0},
+{-3.0, -1.0, 3.0, 4.0, 4.0, 3.0, -1.0, -3.0},
+{-3.0, -1.0, 3.0, 4.0, 4.0, 3.0, -1.0, -3.0},
+{-3.0, -1.0, 2.0, 3.0, 3.0, 2.0, -1.0, -3.0},
+{-3.0, -3.0, 0.0, 0.0, 0.0, 0.0, -3.0, -3.0},
+{-5.0, -3.0, -3.0, -3.0, -3.0, -3.0, -3.0, -5.0}};
+
+// how much each piece type counts towards the game phase, the phase is "MAX_GAME_PHASE" with all pieces on the board and 0 with only kings and pawns
+static const short PHASE_WEIGHTS[6] = {0, 4, 1, 1, 2, 0};		// [PieceTypes]
+
+// pawn structure scores in terms of points, [0] for the middlegame and [1] for the endgame
+static const float DOUBLED_PAWN_PENALTY[2] = {1.0, 2.0};		// for every pawn on a file after the first one
+static const float ISOLATED_PAWN_PENALTY[2] = {1.0, 1.5};		// no pawn of the same team on the neighbouring files
+static const float BACKWARD_PAWN_PENALTY[2] = {0.8, 1.0};		// no pawn of the same team on the neighbouring files can support it and its way forward is guarded by a pawn
+static const float PASSED_PAWN_BONUS[2][BOARD_SIZE] = {{0, 0.5, 1.0, 1.5, 3.0, 5.0, 8.0, 0}, {0, 1.0, 2.0, 3.5, 6.0, 10.0, 15.0, 0}};		// [is_endgame][rank], no pawn can stop it
+static const float PAWN_SHIELD_BONUS[2] = {1.0, 0.5};			// [ranks ahead of the king - 1], for every pawn in front of the king, only in the middlegame
+
+// squares used by the pawn structure evaluation
+static Bitboard FILE_MASKS[BOARD_SIZE];								// [file], the whole file
+static Bitboard NEIGHBOUR_FILE_MASKS[BOARD_SIZE];					// [file], the files on both sides of the file
+static Bitboard PASSED_PAWN_MASKS[2][BOARD_SIZE*BOARD_SIZE];		// [is_white][square], the squares ahead of a pawn on its own and the neighbouring files
+static Bitboard SUPPORT_MASKS[2][BOARD_SIZE*BOARD_SIZE];			// [is_white][square], the squares of the neighbouring files on the pawn's rank and behind it
+static Bitboard PAWN_SHIELD_MASKS[2][BOARD_SIZE*BOARD_SIZE][2];		// [is_white][king's square][ranks ahead - 1], the three squares in front of the king
+
+float PIECE_SQUARE_SCORES[2][W_PAWN-B_KING+1][BOARD_SIZE*BOARD_SIZE];
+int PIECE_PHASE_WEIGHTS[W_PAWN-B_KING+1];
+
+// fills the piece-square score tables, black pieces see the position tables upside down, and the pawn structure masks
+static bool InitEvaluationTables() noexcept {
+	for(short type=KING;type<=PAWN;++type)
+		for(short square=0;square<BOARD_SIZE*BOARD_SIZE;++square) {
+			const short &y = square/BOARD_SIZE, &x = square%BOARD_SIZE;
+			for(short white=0;white<2;++white) {
+				const short &row = white ? y : BOARD_SIZE - y - 1, &sign = white ? 1 : -1, &piece = white ? W_KING + type : B_KING + type;
+				PIECE_SQUARE_SCORES[0][piece - B_KING][square] = sign * (Chess::EvaluatePiece(type+1) + PIECE_POS_POINTS[type][row][x]);
+				PIECE_SQUARE_SCORES[1][piece - B_KING][square] = sign * (Chess::EvaluatePiece(type+1) + (type == KING ? KING_ENDGAME_POS_POINTS : PIECE_POS_POINTS[type])[row][x]);
+				PIECE_PHASE_WEIGHTS[piece - B_KING] = PHASE_WEIGHTS[type];
+			}
+		}
+	for(short x=0;x<BOARD_SIZE;++x) {
+		FILE_MASKS[x] = 0;
+		for(short y=0;y<BOARD_SIZE;++y)
+			FILE_MASKS[x] |= Bitboard(1) << (y*BOARD_SIZE + x);
+	}
+	for(short x=0;x<BOARD_SIZE;++x)
+		NEIGHBOUR_FILE_MASKS[x] = (x > 0 ? FILE_MASKS[x-1] : 0) | (x < BOARD_SIZE-1 ? FILE_MASKS[x+1] : 0);
+	for(short white=0;white<2;++white)
+		for(short square=0;square<BOARD_SIZE*BOARD_SIZE;++square) {
+			const short &x = square%BOARD_SIZE, &y = square/BOARD_SIZE, &forward = white ? -1 : 1;
+			PASSED_PAWN_MASKS[white][square] = SUPPORT_MASKS[white][square] = 0;
+			PAWN_SHIELD_MASKS[white][square][0] = PAWN_SHIELD_MASKS[white][square][1] = 0;
+			for(short row=0;row<BOARD_SIZE;++row) {
+				const Bitboard &rank = Bitboard(0xFF) << (row*BOARD_SIZE);
+				if((row - y) * forward > 0)
+					PASSED_PAWN_MASKS[white][square] |= rank & (FILE_MASKS[x] | NEIGHBOUR_FILE_MASKS[x]);
+				else
+					SUPPORT_MASKS[white][square] |= rank & NEIGHBOUR_FILE_MASKS[x];
+				if((row - y) * forward == 1 || (row - y) * forward == 2)
+					PAWN_SHIELD_MASKS[white][square][(row - y) * forward - 1] = rank & (FILE_MASKS[x] | NEIGHBOUR_FILE_MASKS[x]);
+			}
+		}
+	return true;
+}
+
+static const bool EVALUATION_TABLES_INITIALIZED = InitEvaluationTables();
+
+
+
+// chess class implementation
+
+// constructor of chess class
+Chess::Chess(const std::string &player1, const unsigned short &difficulty1, const std::string &player2, const unsigned short &difficulty2) noexcept
+: white(player1, difficulty1), black(player2, difficulty2) {
+	LoadBoard(STARTING_BOARD);
+	key = ComputeKey();
+	ReserveMoves(1024);		// the game's moves and the moves of its searches
+}
+
+// checks whether the given coordinate is within board boundaries or not
+bool Chess::WithinBounds(const short &coord) noexcept {
+	return coord>=0 && coord<BOARD_SIZE;
+}
+
+// returns the given numerical board coordinates as a string
+std::string Chess::ToString(const short &x1, const short &y1, const short &x2, const short &y2) noexcept {
+	return {static_cast<char>(x1+'a'), static_cast<char>('8'-y1), static_cast<char>(x2+'a'), static_cast<char>('8'-y2)};
+}
+
+// returns the worth of the given piece in terms of points
+float Chess::EvaluatePiece(const char &piece) noexcept {
+	switch(piece) {
+		case W_PAWN:
+		case B_PAWN:	return 10;		// pawn: 10 points
+		case W_ROOK:
+		case B_ROOK:	return 50;		// rook: 50 points
+		case W_KNIGHT:
+		case B_KNIGHT:
+		case W_BISHOP:
+		case B_BISHOP:	return 30;		// knight and bishop: 30 points
+		case W_QUEEN:
+		case B_QUEEN:	return 90;		// queen: 90 points
+		case W_KING:
+		case B_KING:	return 900;		// king: 900 points, but you can assume it is infinite
+		default:		return 0;
+	}
+}
+
+// returns the bitboard index of the given piece regardless of its color, see "PieceTypes"
+short Chess::PieceType(const char &piece) noexcept {
+	return piece + 7*(piece < 0) - 1;
+}
+
+// adds a move from the square "from" to every square in "targets" to the list of moves
+void Chess::AddMoves(MoveList &all_moves, const short &from, Bitboard targets, const MoveFlags &flags) noexcept {
+	while(targets)
+		all_moves.Add(Move(from, PopLeastSignificantSquare(targets), flags));
+}
+
+// adds a pawn move from the square "from" to every square in "targets", moves to the last rank are added once for every promotion piece
+void Chess::AddPawnMoves(MoveList &all_moves, const short &from, Bitboard targets, const MoveFlags &flags) noexcept {
+	while(targets) {
+		const short &to = PopLeastSignificantSquare(targets);
+		if(to < BOARD_SIZE || to >= BOARD_SIZE*(BOARD_SIZE-1))
+			for(short promotion=KNIGHT_PROMOTION;promotion<=QUEEN_PROMOTION;++promotion)
+				all_moves.Add(Move(from, to, static_cast<MoveFlags>(promotion | flags)));
+		else
+			all_moves.Add(Move(from, to, flags));
+	}
+}
+
+// returns the move from "from" to "to" with the given promotion piece if it is in the list of possible moves, a null move otherwise
+Move Chess::FindMove(const short &from, const short &to, const char &promotion, const MoveList &all_moves) noexcept {
+	for(const auto &move : all_moves)
+		if(move.GetFrom() == from && move.GetTo() == to && (!move.IsPromotion() || move.GetPromotionPiece(true) == promotion))
+			return move;
+	return Move();
+}
+
+// resets the game, everything is back to its default value
+void Chess::Reset() noexcept {
+	LoadBoard(STARTING_BOARD);
+	white.Reset();
+	black.Reset();
+	all_game_moves.clear();
+	undo_stack.clear();
+	whites_turn = true;
+	castling_rights = ALL_CASTLING_RIGHTS;
+	en_passant = -1;
+	key = ComputeKey();
+	halfmove_clock = start_ply = 0;
+}
+
+// sets up the position described by the given FEN string, returns false and leaves the game untouched if the string is not a valid FEN
+// or the position cannot arise in a game: each team must have exactly one king and the side that is not to move must not be in check
+bool Chess::LoadFEN(const std::string &fen) noexcept {
+	std::istringstream stream(fen);
+	std::string placement, turn, castling = "-", en_passant_square = "-";
+	if(!(stream >> placement >> turn) || (turn != "w" && turn != "b"))
+		return false;
+	stream >> castling >> en_passant_square;
+	std::string halfmoves = "0", fullmoves = "1";
+	stream >> halfmoves >> fullmoves;				// the move clocks are optional
+	if(halfmoves.find_first_not_of("0123456789") != std::string::npos || fullmoves.find_first_not_of("0123456789") != std::string::npos
+	|| halfmoves.length() > 4 || fullmoves.length() > 4 || !atoi(fullmoves.c_str()))
+		return false;
+	char new_board[BOARD_SIZE][BOARD_SIZE];
+	short x = 0, y = 0;
+	for(const char &ch : placement)
+		if(ch == '/') {
+			if(x != BOARD_SIZE || (++y) == BOARD_SIZE)
+				return false;
+			x = 0;
+		}
+		else if(ch >= '1' && ch <= '8')
+			for(short i='0';i<ch;++i,++x)
+				if(x < BOARD_SIZE)
+					new_board[y][x] = EMPTY;
+				else
+					return false;
+		else {
+			const char *PIECE_LETTERS = "kqbnrp", *piece = strchr(PIECE_LETTERS, tolower(ch));		// in the order of "PieceTypes"
+			if(!piece || !*piece || x == BOARD_SIZE)
+				return false;
+			new_board[y][x++] = piece - PIECE_LETTERS + (isupper(ch) ? W_KING : B_KING);
+		}
+	if(x != BOARD_SIZE || y != BOARD_SIZE-1 || std::count(*new_board, *new_board + BOARD_SIZE*BOARD_SIZE, W_KING) != 1 || std::count(*new_board, *new_board + BOARD_SIZE*BOARD_SIZE, B_KING) != 1)
+		return false;
+	unsigned char new_castling_rights = 0;
+	for(const char &ch : castling)
+		switch(ch) {
+			case 'K':	new_castling_rights |= (new_board[7][4] == W_KING && new_board[7][7] == W_ROOK) * WHITE_KING_SIDE;		break;
+			case 'Q':	new_castling_rights |= (new_board[7][4] == W_KING && new_board[7][0] == W_ROOK) * WHITE_QUEEN_SIDE;	break;
+			case 'k':	new_castling_rights |= (new_board[0][4] == B_KING && new_board[0][7] == B_ROOK) * BLACK_KING_SIDE;		break;
+			case 'q':	new_castling_rights |= (new_board[0][4] == B_KING && new_board[0][0] == B_ROOK) * BLACK_QUEEN_SIDE;	break;
+			case '-':	break;
+			default:	return false;
+		}
+	if(en_passant_square != "-" && (en_passant_square.length() != 2 || en_passant_square[0] < 'a' || en_passant_square[0] > 'h' || en_passant_square[1] != (turn == "w" ? '6' : '3')))
+		return false;
+	Bitboard new_pieces[2][6] = {}, occupied = 0;
+	for(short square=0;square<BOARD_SIZE*BOARD_SIZE;++square)
+		if(new_board[square/BOARD_SIZE][square%BOARD_SIZE] != EMPTY) {
+			const char &piece = new_board[square/BOARD_SIZE][square%BOARD_SIZE];
+			new_pieces[piece > 0][PieceType(piece)] |= Bitboard(1) << square;
+			occupied |= Bitboard(1) << square;
+		}
+	const bool &white_to_move = turn == "w";
+	if(AttackersOf(new_pieces[white_to_move], LeastSignificantSquare(new_pieces[!white_to_move][KING]), white_to_move, occupied))
+		return false;				// the side to move could capture the king
+	LoadBoard(new_board);
+	whites_turn = turn == "w";
+	castling_rights = new_castling_rights;
+	en_passant = en_passant_square == "-" ? -1 : ('8' - en_passant_square[1])*BOARD_SIZE + en_passant_square[0] - 'a';
+	key = ComputeKey();
+	all_game_moves.clear();
+	undo_stack.clear();
+	halfmove_clock = atoi(halfmoves.c_str());
+	start_ply = 2 * (atoi(fullmoves.c_str()) - 1) + !whites_turn;
+	return true;
+}
+
+// returns the FEN string of the current position, the inverse of "LoadFEN"
+std::string Chess::GetFEN() const noexcept {
+	static const char PIECE_LETTERS[] = "kqbnrp";		// in the order of "PieceTypes"
+	std::string fen;
+	for(short y=0;y<BOARD_SIZE;++y) {
+		short empty_squares = 0;
+		for(short x=0;x<BOARD_SIZE;++x)
+			if(board[y][x] == EMPTY)
+				++empty_squares;
+			else {
+				if(empty_squares)
+					fen += '0' + empty_squares;
+				empty_squares = 0;
+				fen += board[y][x] > 0 ? toupper(PIECE_LETTERS[PieceType(board[y][x])]) : PIECE_LETTERS[PieceType(board[y][x])];
+			}
+		if(empty_squares)
+			fen += '0' + empty_squares;
+		if(y < BOARD_SIZE-1)
+			fen += '/';
+	}
+	fen += whites_turn ? " w " : " b ";
+	if(castling_rights & WHITE_KING_SIDE)	fen += 'K';
+	if(castling_rights & WHITE_QUEEN_SIDE)	fen += 'Q';
+	if(castling_rights & BLACK_KING_SIDE)	fen += 'k';
+	if(castling_rights & BLACK_QUEEN_SIDE)	fen += 'q';
+	if(!castling_rights)					fen += '-';
+	fen += en_passant == -1 ? std::string(" -") : std::string(" ") + static_cast<char>(en_passant%BOARD_SIZE + 'a') + static_cast<char>('8' - en_passant/BOARD_SIZE);
+	return fen + " " + std::to_string(halfmove_clock) + " " + std::to_string(GetFullmoveNumber());
+}
+
+// getter method, returns the number of halfmoves played after a pawn moved or a capture happened, the fifty-move rule ends the game at 100
+unsigned short Chess::GetHalfmoveClock() const noexcept {
+	return halfmove_clock;
+}
+
+// returns the number of the move being played, starting from 1 and increased after every move of team black
+unsigned short Chess::GetFullmoveNumber() const noexcept {
+	return (start_ply + undo_stack.size()) / 2 + 1;
+}
+
+// getter method, returns the piece located in the given x and y coordinates
+char Chess::GetPiece(const short &x, const short &y) const noexcept {
+	return board[y][x];
+}
+
+// getter method, returns whether it's team white's turn or not
+bool Chess::GetTurn() const noexcept {
+	return whites_turn;
+}
+
+// getter method, returns the squares of the given team's pieces of the given type, see "PieceTypes"
+Bitboard Chess::GetPieces(const bool &white, const short &type) const noexcept {
+	return pieces[white][type];
+}
+
+// getter method, returns the sides each team can still castle to, see "CastlingRights"
+unsigned char Chess::GetCastlingRights() const noexcept {
+	return castling_rights;
+}
+
+// getter method, returns the square a pawn can move to by capturing en passant, -1 if there is no such square
+short Chess::GetEnPassant() const noexcept {
+	return en_passant;
+}
+
+// getter method, returns the zobrist key of the current position
+uint64_t Chess::GetKey() const noexcept {
+	return key;
+}
+
+// returns a reference to the player object
+Bot& Chess::GetCurrentPlayer() noexcept {
+	return whites_turn ? white : black;
+}
+
+// getter method, returns a reference to the given team's player object
+Bot& Chess::GetPlayer(const bool &white_player) noexcept {
+	return white_player ? white : black;
+}
+
+// getter method, returns a constant reference to the given team's player object
+const Bot& Chess::GetPlayer(const bool &white_player) const noexcept {
+	return white_player ? white : black;
+}
+
+// getter method, returns the record of the moves played throughout the game, see "AppendToAllGameMoves"
+const std::vector<std::pair<Moves, std::string>>& Chess::GetAllGameMoves() const noexcept {
+	return all_game_moves;
+}
+
+// changes whose turn it is so the other player can make its move
+void Chess::ChangeTurn() noexcept {
+	whites_turn = !whites_turn;
+	key ^= ZOBRIST_BLACK_TO_MOVE;
+}
+
+// places the given piece on (x, y), the square must be empty
+void Chess::PutPiece(const short &x, const short &y, const char &piece) noexcept {
+	const Bitboard &bit = Bitboard(1) << (y*BOARD_SIZE + x);
+	board[y][x] = piece;
+	key ^= ZOBRIST_PIECES[piece > 0][PieceType(piece)][y*BOARD_SIZE + x];
+	if(PieceType(piece) == PAWN)
+		pawn_key ^= ZOBRIST_PIECES[piece > 0][PAWN][y*BOARD_SIZE + x];
+	pieces[piece > 0][PieceType(piece)] |= bit;
+	middlegame_score += PIECE_SQUARE_SCORES[0][piece - B_KING][y*BOARD_SIZE + x];
+	endgame_score += PIECE_SQUARE_SCORES[1][piece - B_KING][y*BOARD_SIZE + x];
+	game_phase += PIECE_PHASE_WEIGHTS[piece - B_KING];
+	if(network)
+		network->AddPiece(accumulator, piece, y*BOARD_SIZE + x);
+	occupancy[piece > 0] |= bit;
+	all_pieces |= bit;
+}
+
+// removes the piece located in (x, y), the square must be occupied
+void Chess::RemovePiece(const short &x, const short &y) noexcept {
+	const Bitboard &bit = Bitboard(1) << (y*BOARD_SIZE + x);
+	key ^= ZOBRIST_PIECES[board[y][x] > 0][PieceType(board[y][x])][y*BOARD_SIZE + x];
+	if(PieceType(board[y][x]) == PAWN)
+		pawn_key ^= ZOBRIST_PIECES[board[y][x] > 0][PAWN][y*BOARD_SIZE + x];
+	pieces[board[y][x] > 0][PieceType(board[y][x])] &= ~bit;
+	middlegame_score -= PIECE_SQUARE_SCORES[0][board[y][x] - B_KING][y*BOARD_SIZE + x];
+	endgame_score -= PIECE_SQUARE_SCORES[1][board[y][x] - B_KING][y*BOARD_SIZE + x];
+	game_phase -= PIECE_PHASE_WEIGHTS[board[y][x] - B_KING];
+	if(network)
+		network->RemovePiece(accumulator, board[y][x], y*BOARD_SIZE + x);
+	occupancy[board[y][x] > 0] &= ~bit;
+	all_pieces &= ~bit;
+	board[y][x] = EMPTY;
+}
+
+// places the given piece on (x, y) without touching the zobrist key and the evaluation, "MovePieceBack" restores those from the undo stack,
+// only the network's accumulator is updated since it is too large to be saved on the undo stack
+void Chess::PlacePiece(const short &x, const short &y, const char &piece) noexcept {
+	const Bitboard &bit = Bitboard(1) << (y*BOARD_SIZE + x);
+	board[y][x] = piece;
+	pieces[piece > 0][PieceType(piece)] |= bit;
+	occupancy[piece > 0] |= bit;
+	all_pieces |= bit;
+	if(network)
+		network->AddPiece(accumulator, piece, y*BOARD_SIZE + x);
+}
+
+// removes the piece located in (x, y) without touching the zobrist key and the evaluation, the square must be occupied, see "PlacePiece"
+void Chess::ClearSquare(const short &x, const short &y) noexcept {
+	const Bitboard &bit = ~(Bitboard(1) << (y*BOARD_SIZE + x));
+	if(network)
+		network->RemovePiece(accumulator, board[y][x], y*BOARD_SIZE + x);
+	pieces[board[y][x] > 0][PieceType(board[y][x])] &= bit;
+	occupancy[board[y][x] > 0] &= bit;
+	all_pieces &= bit;
+	board[y][x] = EMPTY;
+}
+
+// sets up the board and its bitboards from the given board position
+void Chess::LoadBoard(const char new_board[BOARD_SIZE][BOARD_SIZE]) noexcept {
+	std::fill(*pieces, *pieces + 2*6, 0);
+	occupancy[0] = occupancy[1] = all_pieces = 0;
+	middlegame_score = endgame_score = 0;
+	game_phase = 0;
+	pawn_key = 0;
+	for(short y=0;y<BOARD_SIZE;++y)
+		for(short x=0;x<BOARD_SIZE;++x) {
+			board[y][x] = EMPTY;
+			if(new_board[y][x] != EMPTY)
+				PutPiece(x, y, new_board[y][x]);
+		}
+	if(network)
+		network->Refresh(accumulator, board);		// the pieces were added to the accumulator of the previous position
+}
+
+// returns the zobrist key of the en passant square, which only counts if a pawn of the player whose turn it is can capture there
+uint64_t Chess::EnPassantKey() const noexcept {
+	return en_passant != -1 && (PAWN_ATTACKS[!whites_turn][en_passant] & pieces[whites_turn][PAWN]) ? ZOBRIST_EN_PASSANT[en_passant%BOARD_SIZE] : 0;
+}
+
+// computes the zobrist key of the current position from scratch
+uint64_t Chess::ComputeKey() const noexcept {
+	uint64_t new_key = ZOBRIST_CASTLING[castling_rights] ^ EnPassantKey() ^ (whites_turn ? 0 : ZOBRIST_BLACK_TO_MOVE);
+	for(short color=0;color<2;++color)
+		for(short type=KING;type<=PAWN;++type)
+			for(Bitboard b = pieces[color][type]; b;)
+				new_key ^= ZOBRIST_PIECES[color][type][PopLeastSignificantSquare(b)];
+	return new_key;
+}
+
+// returns the pieces of the given team that attack the square when the squares in "occupied" are occupied
+Bitboard Chess::AttackersOf(const short &square, const bool &by_white, const Bitboard &occupied) const noexcept {
+	return AttackersOf(pieces[by_white], square, by_white, occupied);
+}
+
+// function overload, returns the squares of the given team's pieces in "attackers" ([PieceTypes]) that attack the square
+Bitboard Chess::AttackersOf(const Bitboard (&attackers)[6], const short &square, const bool &by_white, const Bitboard &occupied) noexcept {
+	return (PAWN_ATTACKS[!by_white][square] & attackers[PAWN]) | (KNIGHT_ATTACKS[square] & attackers[KNIGHT]) | (KING_ATTACKS[square] & attackers[KING])
+	| (BishopAttacks(square, occupied) & (attackers[BISHOP] | attackers[QUEEN])) | (RookAttacks(square, occupied) & (attackers[ROOK] | attackers[QUEEN]));
+}
+
+// returns true if any piece of the given team attacks the square, false otherwise
+bool Chess::IsSquareAttacked(const short &square, const bool &by_white) const noexcept {
+	return AttackersOf(square, by_white, all_pieces);
+}
+
+// appends the move that is about to be made to "all_game_moves" list, the record holds the starting and ending points of the moving piece,
+// the moving piece, the captured piece and the promoted piece
+void Chess::AppendToAllGameMoves(const Move &move) noexcept {
+	const short &x1 = move.GetFrom()%BOARD_SIZE, &y1 = move.GetFrom()/BOARD_SIZE, &x2 = move.GetTo()%BOARD_SIZE, &y2 = move.GetTo()/BOARD_SIZE;
+	const Moves &type = move.IsCastling() ? CASTLING : move.IsPromotion() ? PROMOTION : move.IsEnPassant() ? EN_PASSANT : NORMAL;
+	all_game_moves.emplace_back(type, ToString(x1, y1, x2, y2) + board[y1][x1] + board[y2][x2]);
+	all_game_moves.back().second += move.IsPromotion() ? move.GetPromotionPiece(whites_turn) : static_cast<char>(EMPTY);
+}
+
+// returns true if the current position occurred the given number of times, counting itself, only the positions after the last
+// pawn move or capture can repeat it and only every other one has the same side to move, so just those zobrist keys are compared
+bool Chess::IsRepetition(const unsigned short &times) const noexcept {
+	unsigned short position_count = 1;
+	const size_t reversible_moves = std::min<size_t>(halfmove_clock, undo_stack.size());
+	for(size_t i=4;i<=reversible_moves;i+=2)		// it takes at least four halfmoves to get back to the same position
+		if(undo_stack[undo_stack.size()-i].key == key && (++position_count) == times)
+			return true;
+	return false;
+}
+
+// seeds the game's random number generator, games seeded with the same number make the same random choices
+void Chess::SeedRandom(const uint64_t &seed) noexcept {
+	random_state = seed;
+}
+
+// setter method, gives both bots the given opening book to play from for the first "depth" halfmoves of the game
+void Chess::SetBook(const std::shared_ptr<const OpeningBook> &book, const unsigned short &depth) noexcept {
+	white.SetBook(book, depth);
+	black.SetBook(book, depth);
+}
+
+// setter method, gives both bots the given endgame tablebases to look positions with few pieces up in
+void Chess::SetTablebases(const std::shared_ptr<const Tablebases> &tablebases) noexcept {
+	white.SetTablebases(tablebases);
+	black.SetTablebases(tablebases);
+}
+
+// setter method, gives both bots the given neural network to evaluate positions with, the piece-square tables are used if it is null
+void Chess::SetNetwork(const std::shared_ptr<const NeuralNetwork> &network) noexcept {
+	white.SetNetwork(network);
+	black.SetNetwork(network);
+}
+
+// makes sure the given number of moves more can be made without reallocating the undo stack, a search pushes its moves on it too
+// and a copied game only has room for the moves already played
+void Chess::ReserveMoves(const size_t &moves) noexcept {
+	undo_stack.reserve(undo_stack.size() + moves);
+}
+
+// makes the position evaluate with the given neural network, or with the piece-square tables if it is null, the accumulator is computed
+// from scratch if the network changes and kept up to date by every move after that
+void Chess::UseNetwork(const std::shared_ptr<const NeuralNetwork> &neural_network) noexcept {
+	if(network == neural_network)
+		return;
+	network = neural_network;
+	if(network)
+		network->Refresh(accumulator, board);
+}
+
+// returns the next pseudo-random number of the game's random number generator (splitmix64), every game has its own generator
+// so games running on different threads never share any state
+uint64_t Chess::NextRandom() noexcept {
+	uint64_t z = (random_state += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+// returns the legal move written in coordinate notation, e.g. "e2e4" or "e7e8q", a null move if the player cannot make such a move
+Move Chess::ParseMove(const std::string &text) noexcept {
+	MoveList all_moves;
+	AllMoves(all_moves);
+	for(const auto &move : all_moves)
+		if(move.ToString() == ToLowerString(text))
+			return move;
+	return Move();
+}
+
+// returns true if the player's king is in check, false otherwise
+bool Chess::IsCheck(const bool &turn) const noexcept {
+	return IsSquareAttacked(LeastSignificantSquare(pieces[turn][KING]), !turn);
+}
+
+// returns a list of all possible moves the pawn located in (x, y) can make to the squares in "allowed"
+void Chess::PawnMoves(MoveList &all_moves, const short &x, const short &y, const Bitboard &allowed, const bool &captures_only) const noexcept {
+	const short &inc = whites_turn ? -1 : 1, &square = y*BOARD_SIZE + x;
+	if(board[y+inc][x] == EMPTY && (!captures_only || y+inc == 7*!whites_turn)) {		// promotions are generated along with captures
+		AddPawnMoves(all_moves, square, (Bitboard(1) << (square + inc*BOARD_SIZE)) & allowed, QUIET);		// 1 square forward
+		if(!captures_only && (y == 1 + 5*whites_turn) && (board[y + 2*inc][x] == EMPTY) && (allowed & (Bitboard(1) << (square + 2*inc*BOARD_SIZE))))
+			all_moves.Add(Move(square, square + 2*inc*BOARD_SIZE, DOUBLE_PAWN_PUSH));		// 2 squares forward
+	}
+	AddPawnMoves(all_moves, square, PAWN_ATTACKS[whites_turn][square] & occupancy[!whites_turn] & allowed, CAPTURE);		// diagonal attack moves
+}
+
+// returns a list of all possible moves the rook located in (x, y) can make to the squares in "allowed"
+void Chess::RookMoves(MoveList &all_moves, const short &x, const short &y, const Bitboard &allowed, const bool &captures_only) const noexcept {
+	const short &square = y*BOARD_SIZE + x;
+	const Bitboard &attacks = RookAttacks(square, all_pieces) & allowed;
+	if(!captures_only)
+		AddMoves(all_moves, square, attacks & ~all_pieces, QUIET);
+	AddMoves(all_moves, square, attacks & occupancy[!whites_turn], CAPTURE);
+}
+
+// returns a list of all possible moves the knight located in (x, y) can make to the squares in "allowed"
+void Chess::KnightMoves(MoveList &all_moves, const short &x, const short &y, const Bitboard &allowed, const bool &captures_only) const noexcept {
+	const short &square = y*BOARD_SIZE + x;
+	const Bitboard &attacks = KNIGHT_ATTACKS[square] & allowed;
+	if(!captures_only)
+		AddMoves(all_moves, square, attacks & ~all_pieces, QUIET);
+	AddMoves(all_moves, square, attacks & occupancy[!whites_turn], CAPTURE);
+}
+
+// returns a list of all possible moves the bishop located in (x, y) can make to the squares in "allowed"
+void Chess::BishopMoves(MoveList &all_moves, const short &x, const short &y, const Bitboard &allowed, const bool &captures_only) const noexcept {
+	const short &square = y*BOARD_SIZE + x;
+	const Bitboard &attacks = BishopAttacks(square, all_pieces) & allowed;
+	if(!captures_only)
+		AddMoves(all_moves, square, attacks & ~all_pieces, QUIET);
+	AddMoves(all_moves, square, attacks & occupancy[!whites_turn], CAPTURE);
+}
+
+// returns a list of all possible moves the queen located in (x, y) can make to the squares in "allowed"
+void Chess::QueenMoves(MoveList &all_moves, const short &x, const short &y, const Bitboard &allowed, const bool &captures_only) const noexcept {
+	const short &square = y*BOARD_SIZE + x;
+	const Bitboard &attacks = (RookAttacks(square, all_pieces) | BishopAttacks(square, all_pieces)) & allowed;		// queen = rook + bishop
+	if(!captures_only)
+		AddMoves(all_moves, square, attacks & ~all_pieces, QUIET);
+	AddMoves(all_moves, square, attacks & occupancy[!whites_turn], CAPTURE);
+}
+
+// returns a list of all possible moves the king located in (x, y) can make, the king never moves to a square the opponent attacks
+void Chess::KingMoves(MoveList &all_moves, const short &x, const short &y, const bool &in_check, const bool &captures_only) const noexcept {
+	const short &square = y*BOARD_SIZE + x;
+	const Bitboard &occupied = all_pieces ^ (Bitboard(1) << square);		// the king does not block the attacks along the line it moves on
+	for(Bitboard targets = KING_ATTACKS[square] & (captures_only ? occupancy[!whites_turn] : ~occupancy[whites_turn]); targets;) {
+		const short &target = PopLeastSignificantSquare(targets);		// add moves within 1 square reach
+		if(!AttackersOf(target, !whites_turn, occupied))
+			all_moves.Add(Move(square, target, board[target/BOARD_SIZE][target%BOARD_SIZE] == EMPTY ? QUIET : CAPTURE));
+	}
+	if(!captures_only && !in_check && (castling_rights & (whites_turn ? WHITE_KING_SIDE | WHITE_QUEEN_SIDE : BLACK_KING_SIDE | BLACK_QUEEN_SIDE))) {
+		const Bitboard &castling_occupied = all_pieces >> (square - 4);		// add castling moves if castling is possible, the king cannot castle out of, through or into check
+		if((castling_rights & (whites_turn ? WHITE_QUEEN_SIDE : BLACK_QUEEN_SIDE)) && !(castling_occupied & 0x0E) && !IsSquareAttacked(square-1, !whites_turn) && !IsSquareAttacked(square-2, !whites_turn))
+			all_moves.Add(Move(square, square-2, QUEEN_CASTLE));	// long castling
+		if((castling_rights & (whites_turn ? WHITE_KING_SIDE : BLACK_KING_SIDE)) && !(castling_occupied & 0x60) && !IsSquareAttacked(square+1, !whites_turn) && !IsSquareAttacked(square+2, !whites_turn))
+			all_moves.Add(Move(square, square+2, KING_CASTLE));		// short castling
+	}
+}
+
+// returns a list of the en passant captures the player can make, an en passant capture removes two pawns from the same rank at once so its legality
+// is checked by looking at the board after the capture
+void Chess::EnPassantMoves(MoveList &all_moves, const short &king_square, const Bitboard &check_mask) const noexcept {
+	const short &captured = en_passant + (whites_turn ? BOARD_SIZE : -BOARD_SIZE);
+	if(!(check_mask & ((Bitboard(1) << en_passant) | (Bitboard(1) << captured))))
+		return;			// the capture neither blocks the check nor removes the checking pawn
+	const Bitboard (&opponent)[6] = pieces[!whites_turn];
+	for(Bitboard capturers = PAWN_ATTACKS[!whites_turn][en_passant] & pieces[whites_turn][PAWN]; capturers;) {
+		const short &from = PopLeastSignificantSquare(capturers);
+		const Bitboard &occupied = (all_pieces ^ (Bitboard(1) << from) ^ (Bitboard(1) << captured)) | (Bitboard(1) << en_passant);
+		if(!(RookAttacks(king_square, occupied) & (opponent[ROOK] | opponent[QUEEN])) && !(BishopAttacks(king_square, occupied) & (opponent[BISHOP] | opponent[QUEEN])))
+			all_moves.Add(Move(from, en_passant, EN_PASSANT_CAPTURE));
+	}
+}
+
+// returns the pieces of the player whose turn it is that are pinned to their king, a pinned piece can only move along the line through the king
+Bitboard Chess::PinnedPieces(const short &king_square) const noexcept {
+	const Bitboard (&opponent)[6] = pieces[!whites_turn];
+	Bitboard pinned = 0;
+	for(Bitboard snipers = (RookAttacks(king_square, 0) & (opponent[ROOK] | opponent[QUEEN])) | (BishopAttacks(king_square, 0) & (opponent[BISHOP] | opponent[QUEEN])); snipers;) {
+		const Bitboard &blockers = BETWEEN[king_square][PopLeastSignificantSquare(snipers)] & all_pieces;
+		if(PopCount(blockers) == 1)
+			pinned |= blockers & occupancy[whites_turn];
+	}
+	return pinned;
+}
+
+// fills the list with all legal moves the player can make, or only with the captures and promotions if "captures_only" is true,
+// the checking pieces and pinned pieces are found once, in check the other pieces may only capture the checker or block the check
+// and pinned pieces may only move along their pin, so every generated move is legal without playing it
+void Chess::AllMoves(MoveList &all_moves, const bool &captures_only) noexcept {
+#if COUNT_ALLOCATIONS
+	const unsigned long long &allocations = GetAllocationCount();
+#endif
+	all_moves.Clear();
+	const short &king_square = LeastSignificantSquare(pieces[whites_turn][KING]);
+	const Bitboard &checkers = AttackersOf(king_square, !whites_turn, all_pieces);
+	KingMoves(all_moves, king_square%BOARD_SIZE, king_square/BOARD_SIZE, checkers, captures_only);
+	if(PopCount(checkers) < 2) {		// in double check only the king can move
+		const Bitboard &check_mask = checkers ? BETWEEN[king_square][LeastSignificantSquare(checkers)] | checkers : ~Bitboard(0);
+		const Bitboard &pinned = PinnedPieces(king_square);
+		for(Bitboard own_pieces = occupancy[whites_turn] & ~pieces[whites_turn][KING]; own_pieces;) {
+			const short &square = PopLeastSignificantSquare(own_pieces), &x = square%BOARD_SIZE, &y = square/BOARD_SIZE;
+			const Bitboard &allowed = pinned & (Bitboard(1) << square) ? check_mask & LINE[king_square][square] : check_mask;
+			switch(PieceType(board[y][x])) {
+				case PAWN:
+					PawnMoves(all_moves, x, y, allowed, captures_only);
+					break;
+				case ROOK:
+					RookMoves(all_moves, x, y, allowed, captures_only);
+					break;
+				case KNIGHT:
+					KnightMoves(all_moves, x, y, allowed, captures_only);
+					break;
+				case BISHOP:
+					BishopMoves(all_moves, x, y, allowed, captures_only);
+					break;
+				case QUEEN:
+					QueenMoves(all_moves, x, y, allowed, captures_only);
+			}
+		}
+		if(en_passant != -1)
+			EnPassantMoves(all_moves, king_square, check_mask);
+	}
+#if COUNT_ALLOCATIONS
+	assert(GetAllocationCount() == allocations);		// move generation must not touch the heap
+#endif
+}
+
+// returns a random move the player can make
+Move Chess::GetRandomMove() noexcept {
+	MoveList all_moves;
+	AllMoves(all_moves);
+	return all_moves[GetRandomNumber<unsigned short>(0, all_moves.Size() - 1)];
+}
+
+// plays the given move in the game, records it in "all_game_moves" and adds the worth of the captured piece to the player's score
+void Chess::PlayMove(const Move &move) noexcept {
+	AppendToAllGameMoves(move);
+	if(move.IsCapture())
+		GetCurrentPlayer().IncreaseScore(EvaluatePiece(move.IsEnPassant() ? static_cast<char>(W_PAWN) : board[move.GetTo()/BOARD_SIZE][move.GetTo()%BOARD_SIZE]));
+	MovePiece(move);
+}
+
+// makes the given move, the state "MovePieceBack" needs to undo it is pushed on the undo stack, the game record is left untouched
+void Chess::MovePiece(const Move &move) noexcept {
+	static const unsigned char CASTLING_MASK[BOARD_SIZE*BOARD_SIZE] = {		// the castling rights that survive a move from or to each square
+		static_cast<unsigned char>(~BLACK_QUEEN_SIDE), 15, 15, 15, static_cast<unsigned char>(~(BLACK_KING_SIDE | BLACK_QUEEN_SIDE)), 15, 15, static_cast<unsigned char>(~BLACK_KING_SIDE),
+		15, 15, 15, 15, 15, 15, 15, 15,		15, 15, 15, 15, 15, 15, 15, 15,		15, 15, 15, 15, 15, 15, 15, 15,
+		15, 15, 15, 15, 15, 15, 15, 15,		15, 15, 15, 15, 15, 15, 15, 15,		15, 15, 15, 15, 15, 15, 15, 15,
+		static_cast<unsigned char>(~WHITE_QUEEN_SIDE), 15, 15, 15, static_cast<unsigned char>(~(WHITE_KING_SIDE | WHITE_QUEEN_SIDE)), 15, 15, static_cast<unsigned char>(~WHITE_KING_SIDE)};
+	const short &x1 = move.GetFrom()%BOARD_SIZE, &y1 = move.GetFrom()/BOARD_SIZE, &x2 = move.GetTo()%BOARD_SIZE, &y2 = move.GetTo()/BOARD_SIZE;
+	const char captured = board[y2][x2];
+	undo_stack.push_back({key, pawn_key, middlegame_score, endgame_score, game_phase, en_passant, halfmove_clock, castling_rights, captured});
+	halfmove_clock = move.IsCapture() || PieceType(board[y1][x1]) == PAWN ? 0 : halfmove_clock + 1;
+	key ^= EnPassantKey() ^ ZOBRIST_CASTLING[castling_rights];
+	if(move.IsPromotion()) {
+		RemovePiece(x1, y1);
+		PutPiece(x1, y1, move.GetPromotionPiece(whites_turn));
+	}
+	else if(move.IsEnPassant())
+		RemovePiece(x2, y1);
+	else if(move.IsCastling()) {
+		const short &rook_from = move.GetFlags() == QUEEN_CASTLE ? 0 : 7, &rook_to = move.GetFlags() == QUEEN_CASTLE ? 3 : 5;
+		PutPiece(rook_to, y1, board[y1][rook_from]);
+		RemovePiece(rook_from, y1);
+	}
+	castling_rights &= CASTLING_MASK[move.GetFrom()] & CASTLING_MASK[move.GetTo()];
+	en_passant = move.GetFlags() == DOUBLE_PAWN_PUSH ? (move.GetFrom() + move.GetTo()) / 2 : -1;
+	if(captured != EMPTY)
+		RemovePiece(x2, y2);
+	PutPiece(x2, y2, board[y1][x1]);
+	RemovePiece(x1, y1);
+	ChangeTurn();		// it's the opponent's turn
+	key ^= EnPassantKey() ^ ZOBRIST_CASTLING[castling_rights];
+}
+
+// undoes the given move, the opposite of the "MovePiece" function, the pieces are moved back and everything else is restored from the undo stack
+void Chess::MovePieceBack(const Move &move) noexcept {
+	const short &x1 = move.GetFrom()%BOARD_SIZE, &y1 = move.GetFrom()/BOARD_SIZE, &x2 = move.GetTo()%BOARD_SIZE, &y2 = move.GetTo()/BOARD_SIZE;
+	const UndoInfo &undo = undo_stack.back();
+	whites_turn = !whites_turn;
+	PlacePiece(x1, y1, move.IsPromotion() ? static_cast<char>(whites_turn ? W_PAWN : B_PAWN) : board[y2][x2]);
+	ClearSquare(x2, y2);
+	if(undo.captured != EMPTY)
+		PlacePiece(x2, y2, undo.captured);
+	else if(move.IsEnPassant())
+		PlacePiece(x2, y1, whites_turn ? B_PAWN : W_PAWN);
+	else if(move.IsCastling()) {
+		const short &rook_from = move.GetFlags() == QUEEN_CASTLE ? 0 : 7, &rook_to = move.GetFlags() == QUEEN_CASTLE ? 3 : 5;
+		PlacePiece(rook_from, y1, board[y1][rook_to]);
+		ClearSquare(rook_to, y1);
+	}
+	key = undo.key;
+	pawn_key = undo.pawn_key;
+	middlegame_score = undo.middlegame_score;
+	endgame_score = undo.endgame_score;
+	game_phase = undo.game_phase;
+	en_passant = undo.en_passant;
+	halfmove_clock = undo.halfmove_clock;
+	castling_rights = undo.castling_rights;
+	undo_stack.pop_back();
+}
+
+// returns the worth of the board position in terms of points, with the neural network if the position has one and otherwise with the
+// piece-square tables, see "BlendEvaluation"
+float Chess::EvaluateBoard(const bool &turn, PawnHashTable *pawn_table) const noexcept {
+	if(network) {
+#if CHECK_EVALUATION
+		Accumulator full_accumulator;
+		network->Refresh(full_accumulator, board);
+		for(short perspective=0;perspective<2;++perspective)
+			assert(std::equal(accumulator.values[perspective], accumulator.values[perspective] + network->GetHiddenSize(), full_accumulator.values[perspective]));
+#endif
+		return network->Evaluate(accumulator, turn) / 10.0f;		// from centipawns to points
+	}
+#if CHECK_EVALUATION
+	float full_middlegame_score, full_endgame_score;
+	short full_game_phase;
+	ComputeEvaluation(full_middlegame_score, full_endgame_score, full_game_phase);
+	assert(full_middlegame_score == middlegame_score && full_endgame_score == endgame_score && full_game_phase == game_phase);
+#endif
+	return BlendEvaluation(pieces, pawn_key, turn, middlegame_score, endgame_score, game_phase, pawn_table);
+}
+
+// returns the worth of the position with the given pieces in terms of points from the given material and position scores and the pawn structure
+// scores, the middlegame and endgame scores are blended by the game phase, the pawn structure scores are looked up by the given pawn key in the given
+// pawn hash table and computed and stored there if they are not found
+float Chess::BlendEvaluation(const Bitboard (&pieces)[2][6], const uint64_t &pawn_key, const bool &turn, const float &material_middlegame_score, const float &material_endgame_score, const short &material_game_phase, PawnHashTable *pawn_table) noexcept {
+	float pawn_middlegame_score, pawn_endgame_score;
+	if(!pawn_table || !pawn_table->Probe(pawn_key, pawn_middlegame_score, pawn_endgame_score)) {
+		EvaluatePawns(pieces, pawn_middlegame_score, pawn_endgame_score);
+		if(pawn_table)
+			pawn_table->Store(pawn_key, pawn_middlegame_score, pawn_endgame_score);
+	}
+#if CHECK_EVALUATION
+	else {
+		float full_middlegame_score, full_endgame_score;
+		EvaluatePawns(pieces, full_middlegame_score, full_endgame_score);
+		assert(full_middlegame_score == pawn_middlegame_score && full_endgame_score == pawn_endgame_score);
+	}
+#endif
+	const short phase = std::min<short>(material_game_phase, MAX_GAME_PHASE);		// promotions can push the phase above its maximum
+	const float &total_middlegame_score = material_middlegame_score + pawn_middlegame_score + EvaluatePawnShield(pieces, true) - EvaluatePawnShield(pieces, false);
+	const float &total_evaluation = (total_middlegame_score * phase + (material_endgame_score + pawn_endgame_score) * (MAX_GAME_PHASE - phase)) / MAX_GAME_PHASE;
+	return (turn ? 1 : -1) * total_evaluation;
+}
+
+// computes the pawn structure scores of the given pieces in the middlegame and in the endgame from team white's point of view: doubled, isolated and backward pawns
+// are penalized and passed pawns are rewarded more the further they are, the scores depend on the pawns alone so they can be cached by the pawn key
+void Chess::EvaluatePawns(const Bitboard (&pieces)[2][6], float &pawn_middlegame_score, float &pawn_endgame_score) noexcept {
+	pawn_middlegame_score = pawn_endgame_score = 0;
+	for(short white=0;white<2;++white) {
+		const Bitboard &own = pieces[white][PAWN], &enemy = pieces[!white][PAWN];
+		const short &sign = white ? 1 : -1;
+		for(short x=0;x<BOARD_SIZE;++x) {
+			const short &file_pawns = PopCount(own & FILE_MASKS[x]);
+			if(file_pawns > 1) {
+				pawn_middlegame_score -= sign * DOUBLED_PAWN_PENALTY[0] * (file_pawns - 1);
+				pawn_endgame_score -= sign * DOUBLED_PAWN_PENALTY[1] * (file_pawns - 1);
+			}
+		}
+		for(Bitboard b = own; b;) {
+			const short &square = PopLeastSignificantSquare(b), &x = square%BOARD_SIZE, &rank = white ? BOARD_SIZE-1 - square/BOARD_SIZE : square/BOARD_SIZE;
+			if(!(own & NEIGHBOUR_FILE_MASKS[x])) {
+				pawn_middlegame_score -= sign * ISOLATED_PAWN_PENALTY[0];
+				pawn_endgame_score -= sign * ISOLATED_PAWN_PENALTY[1];
+			}
+			else if(!(own & SUPPORT_MASKS[white][square]) && (PAWN_ATTACKS[white][square + (white ? -BOARD_SIZE : BOARD_SIZE)] & enemy)) {
+				pawn_middlegame_score -= sign * BACKWARD_PAWN_PENALTY[0];
+				pawn_endgame_score -= sign * BACKWARD_PAWN_PENALTY[1];
+			}
+			if(!(enemy & PASSED_PAWN_MASKS[white][square])) {
+				pawn_middlegame_score += sign * PASSED_PAWN_BONUS[0][rank];
+				pawn_endgame_score += sign * PASSED_PAWN_BONUS[1][rank];
+			}
+		}
+	}
+}
+
+// returns the middlegame bonus of the given team's pawns that shelter its king from the front
+float Chess::EvaluatePawnShield(const Bitboard (&pieces)[2][6], const bool &white) noexcept {
+	const short &king_square = LeastSignificantSquare(pieces[white][KING]);
+	return PAWN_SHIELD_BONUS[0] * PopCount(pieces[white][PAWN] & PAWN_SHIELD_MASKS[white][king_square][0])
+		+ PAWN_SHIELD_BONUS[1] * PopCount(pieces[white][PAWN] & PAWN_SHIELD_MASKS[white][king_square][1]);
+}
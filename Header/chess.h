@@ -1,162 +1,763 @@
-#ifndef CHESS_H
-#define CHESS_H
-
-#define BOARD_SIZE 8
-#define BOX_WIDTH 10
-#define DOWN 3
-#define RIGHT 10
-#define TO_DOWN std::string(DOWN, '\n')
-#define TO_RIGHT std::string(RIGHT, ' ')
-#define CLEAR_LINE std::string(100, ' ')
-#define MOVES_PER_LINE 5
-
-#define AGAINST_BOT true			// if true then it's ? vs bot, if false then it's player vs player
-#define TWO_BOTS true				// assuming AGAINST_BOT is true, if true then it's bot vs bot, if false then it's player vs bot
-#define BOT_IS_WHITE false			// assuming AGAINST_BOT is true and TWO_BOTS is false, if true then the bot is team white, black otherwise
-#define WHITE_BOT_RANDOM true		// if true the white bot returns random moves, if false the white bot returns smart moves generated by minimax algorithm
-#define BLACK_BOT_RANDOM false		// if true the black bot returns random moves, if false the black bot returns smart moves generated by minimax algorithm
-#define WHITE_BOT_DIFFICULTY 1		// the tree depth of decision tree of the bot, which is also correlated to the bot's difficulty (aka chess IQ)
-#define BLACK_BOT_DIFFICULTY 1		// 1: easy, 2: medium, 3: hard
-
-// types of chess pieces
-typedef enum {
-	B_KING = -6, B_QUEEN, B_BISHOP, B_KNIGHT, B_ROOK, B_PAWN, EMPTY,
-	W_KING, W_QUEEN, W_BISHOP, W_KNIGHT, W_ROOK, W_PAWN
-} ChessPieces;
-
-// types of player moves
-typedef enum {
-	NORMAL, CASTLING, PROMOTION, EN_PASSANT
-} Moves;
-
-// possible options on how the game can end
-typedef enum {
-	CHECKMATE, FIFTY_MOVES, THREEFOLD_REP, QUIT
-} Endgame;
-
-// starting position of the board
-const char STARTING_BOARD[BOARD_SIZE][BOARD_SIZE] = {{B_ROOK, B_KNIGHT, B_BISHOP, B_QUEEN, B_KING, B_BISHOP, B_KNIGHT, B_ROOK},
-													{B_PAWN, B_PAWN, B_PAWN, B_PAWN, B_PAWN, B_PAWN, B_PAWN, B_PAWN},
-													{EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY},
-													{EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY},
-													{EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY},
-													{EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY},
-													{W_PAWN, W_PAWN, W_PAWN, W_PAWN, W_PAWN, W_PAWN, W_PAWN, W_PAWN},
-													{W_ROOK, W_KNIGHT, W_BISHOP, W_QUEEN, W_KING, W_BISHOP, W_KNIGHT, W_ROOK}};
-
-class Player;
-class PathNode;
-class Bot;
-class Chess;
-
-#include <string>
-#include <forward_list>
-#include <vector>
-#include <map>
-
-// player class declaration
-class Player {
-protected:
-	std::string name;			// name of the player
-	unsigned short score = 0;	// score of the player
-	bool castling = true;		// if true the player can castle, if false the player cannot castle anymore during the game
-public:
-	Player(const std::string &name) noexcept;
-	std::string GetName() const noexcept;
-	unsigned short GetScore() const noexcept;
-	bool GetCastling() const noexcept;
-	void SetCastling(const bool &castling) noexcept;
-	void IncreaseScore(const unsigned short &inc) noexcept;
-	void Reset() noexcept;
-	bool operator== (const Player &p) const noexcept;
-};
-
-// path node class declaration
-class PathNode {
-private:
-	std::map<std::string, PathNode> child_node_list;	// a map where the key (string) corresponds to the player's move and value corresponds to another node, which makes a decision tree
-	void CreateSubtree(Chess &c) noexcept;
-	float AlphaBeta(Chess &c, unsigned short &depth, float alpha, float beta, const bool &maximizing_player, const bool &initial_turn) noexcept;
-public:
-	std::string AlphaBetaRoot(Chess &c, unsigned short &difficulty) noexcept;
-};
-
-// bot class declaration, which inherits from player class
-class Bot : public Player {
-private:
-	PathNode root;					// the root node of the bot's decision tree
-	unsigned short difficulty;		// the depth of the bot's decision tree
-public:
-	Bot(const std::string &name, const unsigned short &difficulty) noexcept;
-	unsigned short GetDifficulty() const noexcept;
-	std::string GetIdealMove(Chess &c) noexcept;
-	std::string GetIdealMove(Chess &c, unsigned short difficulty) noexcept;
-	bool operator== (const Bot &b) const noexcept;
-};
-
-// chess class declaration
-class Chess {
-private:
-	char board[BOARD_SIZE][BOARD_SIZE];		// game board
-	Bot white, black;						// teams
-	std::vector<std::pair<Moves, std::string>> all_game_moves;		// a record which contains all the moves played throughout the game in chronological order
-	bool whites_turn = true;				// if true then it's team white's turn, if false then it's team black's turn
-	unsigned short moves_after_last_pawn_move_or_capture = 0;		// number of moves played after a pawn moved or a capture happened
-	static bool WithinBounds(const short &coord) noexcept;
-	static void ChangeToString(char &x1, char &y1, char &x2, char &y2) noexcept;
-	static std::string ToString(const short &x1, const short &y1, const short &x2, const short &y2) noexcept;
-	static std::string PieceNameToString(const char &piece) noexcept;
-	static float EvaluatePiece(const char &piece) noexcept;
-	static void ClearAllMoves(const unsigned short &n) noexcept;
-	static void PrintSeparator(const char &ch) noexcept;
-	static void CopyBoard(const char from[BOARD_SIZE][BOARD_SIZE], char to[BOARD_SIZE][BOARD_SIZE]) noexcept;
-	static bool AreBoardsEqual(const char board1[BOARD_SIZE][BOARD_SIZE], const char board2[BOARD_SIZE][BOARD_SIZE]) noexcept;
-	static bool CanMovePiece(const short &x1, const short &y1, const short &x2, const short &y2, const std::forward_list<std::string> &all_moves) noexcept;
-	Bot& GetCurrentPlayer() noexcept;
-	Bot GetCurrentPlayerConst() const noexcept;
-	Bot& GetOtherPlayer() noexcept;
-	Bot GetOtherPlayerConst() const noexcept;
-	void ChangeTurn() noexcept;
-	void AppendToAllGameMoves(const short &x1, const short &y1, const short &x2, const short &y2) noexcept;
-	void Reset() noexcept;
-	void CheckCoordinates(const short &x, const short &y, const std::string &func_name) const noexcept(false);
-	bool EndGameText(const unsigned short &n, const Endgame &end_game) const noexcept;
-	short GetEnPassant(const short &x, const short &y) const noexcept;
-	template<class Iterator> short GetEnPassant(const char board[BOARD_SIZE][BOARD_SIZE], const Iterator &it) const noexcept;
-	bool ThreefoldRepetition() const noexcept;
-	bool IsCheck(const bool &turn) const noexcept;
-	bool IsCheck(std::string &move) noexcept;
-	std::forward_list<std::string> PawnMoves(const short &x, const short &y) const noexcept;
-	std::forward_list<std::string> RookMoves(const short &x, const short &y) const noexcept;
-	std::forward_list<std::string> KnightMoves(const short &x, const short &y) const noexcept;
-	std::forward_list<std::string> BishopMoves(const short &x, const short &y) const noexcept;
-	std::forward_list<std::string> QueenMoves(const short &x, const short &y) const noexcept;
-	std::forward_list<std::string> KingMoves(const short &x, const short &y) const noexcept;
-	std::string GetRandomMove() noexcept;
-	void ManuallyPromotePawn(const short &x, const short &y) noexcept;
-	void UpdateBoard(const short &x, const short &y) const noexcept;
-	void UpdateScore(const Bot &p) const noexcept;
-	float EvaluatePosition(const short &x, const short &y) const noexcept;
-	void PrintAllMovesMadeInOrder() const noexcept;
-	bool CheckEndgame(const unsigned short &n = 0) noexcept;
-public:
-	Chess(const std::string &player1, const unsigned short &difficulty1, const std::string &player2, const unsigned short &difficulty2) noexcept;
-	static void ChangeToRealCoordinates(char &x1, char &y1, char &x2, char &y2) noexcept;
-	char GetPiece(const short &x, const short &y) const noexcept;
-	bool GetTurn() const noexcept;
-	std::forward_list<std::string> AllMoves() noexcept;
-	void MovePiece(const short &x1, const short &y1, const short &x2, const short &y2, const bool &manual_promotion, const bool &update_board) noexcept;
-	void MovePieceBack(const short &x1, const short &y1, const short &x2, const short &y2) noexcept;
-	float EvaluateBoard(const bool &turn) const noexcept;
-	void PrintBoard() const noexcept;
-	bool PlayersTurn() noexcept;
-	bool BotsTurn() noexcept;
-	bool GameOver() noexcept;
-};
-
-// other function declarations
-void MoveCursorToXY(const short &x, const short &y) noexcept;
-std::string ToLowerString(std::string s) noexcept;
-template<class T> T GetRandomNumber(const T &min, const T &max) noexcept;
-
-#endif			//CHESS_H
+#ifndef CHESS_H
+#define CHESS_H
+
+#define BOARD_SIZE 8
+#define BOX_WIDTH 10
+#define DOWN 3
+#define RIGHT 10
+#define TO_DOWN std::string(DOWN, '\n')
+#define TO_RIGHT std::string(RIGHT, ' ')
+#define CLEAR_LINE std::string(100, ' ')
+#define MOVES_PER_LINE 5
+#define MAX_MOVES 256				// capacity of a move list, no chess position has more legal moves than this
+#define COUNT_ALLOCATIONS false		// if true every heap allocation is counted and move generation asserts that it allocates nothing
+#define CHECK_EVALUATION false		// if true every evaluation asserts that the incrementally updated scores are equal to a full recomputation
+#define MAX_GAME_PHASE 24			// the game phase at the start of the game, see "PHASE_WEIGHTS"
+#define HASH_SIZE_MB 16				// size of each bot's transposition table in megabytes
+#define HUGE_PAGES false			// if true the transposition tables are allocated on huge (large) pages when the operating system allows it
+#define PAWN_HASH_ENTRIES 16384		// the number of entries of each search thread's pawn hash table, a power of two
+#define EVAL_CACHE_ENTRIES 65536	// the number of entries of each bot's evaluation cache, which its search threads share, a power of two
+
+#define AGAINST_BOT true			// if true then it's ? vs bot, if false then it's player vs player
+#define TWO_BOTS true				// assuming AGAINST_BOT is true, if true then it's bot vs bot, if false then it's player vs bot
+#define BOT_IS_WHITE false			// assuming AGAINST_BOT is true and TWO_BOTS is false, if true then the bot is team white, black otherwise
+#define WHITE_BOT_RANDOM true		// if true the white bot returns random moves, if false the white bot returns smart moves generated by minimax algorithm
+#define BLACK_BOT_RANDOM false		// if true the black bot returns random moves, if false the black bot returns smart moves generated by minimax algorithm
+#define WHITE_BOT_DIFFICULTY 1		// the tree depth of decision tree of the bot, which is also correlated to the bot's difficulty (aka chess IQ)
+#define BLACK_BOT_DIFFICULTY 1		// 1: easy, 2: medium, 3: hard
+#define BOT_MOVE_TIME 0				// if not zero, the bots search for this many seconds per move instead of searching as deep as their difficulty, see "Bot::SetMoveTime"
+#define MAX_SEARCH_DEPTH 64			// the deepest iteration a search can reach, in plies
+#define MAX_PLY 128					// the size of the search stack, the quiescence search stops at this ply
+#define MATE_SCORE 9999				// the score of checkmating, minus the plies from the root of the search to the checkmate
+#define DISTANCE_SCORE 4000			// checkmate and tablebase scores are above this and count plies, evaluations stay far below
+#define BOT_THREADS 1				// number of threads each bot searches with, the extra threads share the transposition table of the bot
+#define BOOK_FILE ""				// if not empty, the bots play their first moves from this opening book, see "OpeningBook"
+#define BOOK_DEPTH 16				// the bots play from the opening book for this many halfmoves of the game at most
+#define TABLEBASE_PATH ""			// if not empty, the bots probe the endgame tablebases in this directory, see "Tablebases"
+#define TABLEBASE_PIECES 4			// the most pieces, kings included, an endgame tablebase can have
+#define TABLEBASE_WIN 5000			// the score of a won tablebase position, minus its distance to mate in plies
+#define NNUE_FILE ""				// if not empty, the bots evaluate positions with the neural network in this file instead of the piece-square tables, see "NeuralNetwork"
+#define NNUE_MAX_HIDDEN 512			// the largest hidden layer a neural network file can have, every position keeps two accumulators of this size
+#define NNUE_SCALE 400				// the network's output times this is the score in centipawns
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_KERNELS true			// the vector kernels are compiled for their own instruction sets and picked at runtime by the CPU's features
+#else
+#define SIMD_KERNELS false			// only the scalar kernels are available
+#endif
+
+// types of chess pieces
+typedef enum {
+	B_KING = -6, B_QUEEN, B_BISHOP, B_KNIGHT, B_ROOK, B_PAWN, EMPTY,
+	W_KING, W_QUEEN, W_BISHOP, W_KNIGHT, W_ROOK, W_PAWN
+} ChessPieces;
+
+// types of chess pieces regardless of their color, also used as the bitboard index of the piece
+typedef enum {
+	KING, QUEEN, BISHOP, KNIGHT, ROOK, PAWN
+} PieceTypes;
+
+// types of player moves
+typedef enum {
+	NORMAL, CASTLING, PROMOTION, EN_PASSANT
+} Moves;
+
+// flags of the compact move encoding, the 3rd bit marks captures and the 4th bit marks promotions
+typedef enum {
+	QUIET, DOUBLE_PAWN_PUSH, KING_CASTLE, QUEEN_CASTLE, CAPTURE, EN_PASSANT_CAPTURE,
+	KNIGHT_PROMOTION = 8, BISHOP_PROMOTION, ROOK_PROMOTION, QUEEN_PROMOTION,
+	KNIGHT_PROMOTION_CAPTURE, BISHOP_PROMOTION_CAPTURE, ROOK_PROMOTION_CAPTURE, QUEEN_PROMOTION_CAPTURE
+} MoveFlags;
+
+// castling rights, each team can castle to each side as long as neither its king nor the rook of that side has moved
+typedef enum {
+	WHITE_KING_SIDE = 1, WHITE_QUEEN_SIDE = 2, BLACK_KING_SIDE = 4, BLACK_QUEEN_SIDE = 8, ALL_CASTLING_RIGHTS = 15
+} CastlingRights;
+
+// types of transposition table scores, a lower (upper) bound means the real score is at least (at most) the stored one
+typedef enum {
+	EXACT_BOUND, LOWER_BOUND, UPPER_BOUND
+} Bounds;
+
+// implementations of the full board evaluation and of the neural network, see "Chess::GetEvaluationKernel",
+// the full board evaluation has no SSE4.1 version and runs the scalar kernel for it
+typedef enum {
+	SCALAR_KERNEL, SSE4_KERNEL, AVX2_KERNEL
+} EvaluationKernels;
+
+// possible options on how the game can end
+typedef enum {
+	CHECKMATE, FIFTY_MOVES, THREEFOLD_REP, QUIT
+} Endgame;
+
+// starting position of the board
+const char STARTING_BOARD[BOARD_SIZE][BOARD_SIZE] = {{B_ROOK, B_KNIGHT, B_BISHOP, B_QUEEN, B_KING, B_BISHOP, B_KNIGHT, B_ROOK},
+													{B_PAWN, B_PAWN, B_PAWN, B_PAWN, B_PAWN, B_PAWN, B_PAWN, B_PAWN},
+													{EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY},
+													{EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY},
+													{EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY},
+													{EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY, EMPTY},
+													{W_PAWN, W_PAWN, W_PAWN, W_PAWN, W_PAWN, W_PAWN, W_PAWN, W_PAWN},
+													{W_ROOK, W_KNIGHT, W_BISHOP, W_QUEEN, W_KING, W_BISHOP, W_KNIGHT, W_ROOK}};
+
+class Move;
+class MoveList;
+class Player;
+class TranspositionTable;
+class PathNode;
+class Bot;
+class Chess;
+class OpeningBook;
+class Tablebases;
+class PawnHashTable;
+class EvaluationCache;
+class NeuralNetwork;
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <fstream>
+#include <map>
+
+// a 64-bit set of board squares, bit (8*y + x) corresponds to the square (x, y)
+typedef uint64_t Bitboard;
+
+// precomputed attack tables, filled once at program start
+extern Bitboard KNIGHT_ATTACKS[BOARD_SIZE*BOARD_SIZE];
+extern Bitboard KING_ATTACKS[BOARD_SIZE*BOARD_SIZE];
+extern Bitboard PAWN_ATTACKS[2][BOARD_SIZE*BOARD_SIZE];		// [is_white][square]
+extern Bitboard RAY_ATTACKS[8][BOARD_SIZE*BOARD_SIZE];		// [direction][square], directions are N, E, S, W, NE, SE, SW, NW
+extern Bitboard BETWEEN[BOARD_SIZE*BOARD_SIZE][BOARD_SIZE*BOARD_SIZE];		// [square1][square2], the squares strictly between two squares on a line, empty if they are not on a line
+extern Bitboard LINE[BOARD_SIZE*BOARD_SIZE][BOARD_SIZE*BOARD_SIZE];		// [square1][square2], the whole line through two squares, empty if they are not on a line
+
+// zobrist key tables, the key of a position is the xor of the keys of its pieces, castling rights, en passant file and side to move
+extern uint64_t ZOBRIST_PIECES[2][6][BOARD_SIZE*BOARD_SIZE];		// [is_white][PieceTypes][square]
+extern uint64_t ZOBRIST_CASTLING[ALL_CASTLING_RIGHTS+1];			// [castling_rights]
+extern uint64_t ZOBRIST_EN_PASSANT[BOARD_SIZE];					// [file]
+extern uint64_t ZOBRIST_BLACK_TO_MOVE;
+
+// evaluation tables, filled once at program start, indexed by the piece itself so the empty squares can be looked up too
+extern float PIECE_SQUARE_SCORES[2][W_PAWN-B_KING+1][BOARD_SIZE*BOARD_SIZE];		// [is_endgame][piece - B_KING][square], material plus position worth, positive for team white, zero for empty squares
+extern int PIECE_PHASE_WEIGHTS[W_PAWN-B_KING+1];									// [piece - B_KING], how much the piece counts towards the game phase
+
+// returns the number of squares in the given bitboard
+inline unsigned short PopCount(const Bitboard &b) noexcept {
+	return __builtin_popcountll(b);
+}
+
+// returns the index of the least significant square in the given non-empty bitboard
+inline short LeastSignificantSquare(const Bitboard &b) noexcept {
+	return __builtin_ctzll(b);
+}
+
+// returns the index of the least significant square in the given non-empty bitboard and removes it from the bitboard
+inline short PopLeastSignificantSquare(Bitboard &b) noexcept {
+	const short square = __builtin_ctzll(b);
+	b &= b - 1;
+	return square;
+}
+
+// returns the squares attacked along the given direction from the square, stopping at the first occupied square
+inline Bitboard RayAttacks(const short &direction, const short &square, const Bitboard &occupied) noexcept {
+	Bitboard attacks = RAY_ATTACKS[direction][square], blockers = attacks & occupied;
+	if(blockers)		// directions E, S, SE, SW go towards higher square indices, the rest towards lower ones
+		attacks ^= RAY_ATTACKS[direction][(direction == 1 || direction == 2 || direction == 5 || direction == 6) ? __builtin_ctzll(blockers) : 63 - __builtin_clzll(blockers)];
+	return attacks;
+}
+
+// returns the squares a rook located in the given square attacks
+inline Bitboard RookAttacks(const short &square, const Bitboard &occupied) noexcept {
+	return RayAttacks(0, square, occupied) | RayAttacks(1, square, occupied) | RayAttacks(2, square, occupied) | RayAttacks(3, square, occupied);
+}
+
+// returns the squares a bishop located in the given square attacks
+inline Bitboard BishopAttacks(const short &square, const Bitboard &occupied) noexcept {
+	return RayAttacks(4, square, occupied) | RayAttacks(5, square, occupied) | RayAttacks(6, square, occupied) | RayAttacks(7, square, occupied);
+}
+
+// move class declaration, a move packed into 16 bits: bits 0-5 source square, bits 6-11 target square, bits 12-15 move flags
+class Move {
+private:
+	unsigned short data = 0;		// a null move if zero
+public:
+	Move() noexcept = default;
+	Move(const short &from, const short &to, const MoveFlags &flags = QUIET) noexcept : data(from | (to << 6) | (flags << 12)) {	}
+	short GetFrom() const noexcept { return data & 0x3F; }
+	short GetTo() const noexcept { return (data >> 6) & 0x3F; }
+	MoveFlags GetFlags() const noexcept { return static_cast<MoveFlags>(data >> 12); }
+	bool IsNull() const noexcept { return !data; }
+	bool IsCapture() const noexcept { return data & 0x4000; }
+	bool IsPromotion() const noexcept { return data & 0x8000; }
+	bool IsCastling() const noexcept { return GetFlags() == KING_CASTLE || GetFlags() == QUEEN_CASTLE; }
+	bool IsEnPassant() const noexcept { return GetFlags() == EN_PASSANT_CAPTURE; }
+	char GetPromotionPiece(const bool &white) const noexcept;
+	std::string ToString() const noexcept;
+	bool operator== (const Move &m) const noexcept { return data == m.data; }
+	bool operator!= (const Move &m) const noexcept { return data != m.data; }
+	bool operator< (const Move &m) const noexcept { return data < m.data; }
+};
+
+// move list class declaration, a fixed-capacity list of moves with a score for each move, meant to live on the stack
+class MoveList {
+private:
+	Move moves[MAX_MOVES];
+	int scores[MAX_MOVES];				// move ordering scores, only meaningful after they are set
+	unsigned short size = 0;
+public:
+	void Add(const Move &move) noexcept { moves[size++] = move; }
+	void Remove(const unsigned short &i) noexcept { moves[i] = moves[--size], scores[i] = scores[size]; }		// the last move takes the removed move's place
+	void Clear() noexcept { size = 0; }
+	unsigned short Size() const noexcept { return size; }
+	bool Empty() const noexcept { return !size; }
+	Move& operator[] (const unsigned short &i) noexcept { return moves[i]; }
+	const Move& operator[] (const unsigned short &i) const noexcept { return moves[i]; }
+	Move* begin() noexcept { return moves; }
+	Move* end() noexcept { return moves + size; }
+	const Move* begin() const noexcept { return moves; }
+	const Move* end() const noexcept { return moves + size; }
+	int GetScore(const unsigned short &i) const noexcept { return scores[i]; }
+	void SetScore(const unsigned short &i, const int &score) noexcept { scores[i] = score; }
+	Move PickBest(const unsigned short &i) noexcept;
+	void Sort() noexcept;
+};
+
+// player class declaration
+class Player {
+protected:
+	std::string name;			// name of the player
+	unsigned short score = 0;	// score of the player
+public:
+	Player(const std::string &name) noexcept;
+	std::string GetName() const noexcept;
+	unsigned short GetScore() const noexcept;
+	void IncreaseScore(const unsigned short &inc) noexcept;
+	void Reset() noexcept;
+	bool operator== (const Player &p) const noexcept;
+};
+
+// transposition table class declaration, a hash table of search results indexed by zobrist keys, each bucket fills a cache line,
+// the search threads share it without locking: an entry stores its key xored with its data, so an entry torn by two threads writing it
+// at once fails the check instead of pairing one position's key with another position's result
+class TranspositionTable {
+private:
+	struct Entry {
+		std::atomic<uint64_t> check{0};		// the zobrist key xored with the data
+		std::atomic<uint64_t> data{0};		// the bits of the score, the best move (or a null move) from bit 32, the depth from bit 48 and from bit 56
+											// the search that stored the entry in the upper 6 bits and the bound plus one in the lower 2 bits, zero if empty
+	};
+	struct alignas(64) Bucket {
+		Entry entries[4];
+	};
+	Bucket *buckets = nullptr;
+	size_t bucket_count = 0;					// always a power of two
+	unsigned char generation = 0;				// counts the searches, used to age out old entries
+	void Free() noexcept;
+	int EntryWorth(const uint64_t &data) const noexcept;
+public:
+	TranspositionTable(const size_t &megabytes, const bool &huge_pages = HUGE_PAGES) noexcept;
+	TranspositionTable(const TranspositionTable&) = delete;
+	TranspositionTable& operator= (const TranspositionTable&) = delete;
+	~TranspositionTable() noexcept;
+	bool Resize(const size_t &megabytes, const bool &huge_pages = HUGE_PAGES) noexcept;
+	void Clear() noexcept;
+	void NewSearch() noexcept;
+	bool Probe(const uint64_t &key, const unsigned short &ply, Move &move, float &score, unsigned short &depth, Bounds &bound) const noexcept;
+	void Store(const uint64_t &key, const unsigned short &ply, const Move &move, const float &score, const unsigned short &depth, const Bounds &bound) noexcept;
+};
+
+// pawn hash table class declaration, caches the pawn structure scores by the zobrist key of the pawns alone, which changes far less often
+// than the position's key, each search thread has its own table so the entries need no synchronization
+class PawnHashTable {
+private:
+	struct Entry {
+		uint64_t key = 0;					// the pawn key, the empty table holds the scores of positions without pawns, which are zero
+		float middlegame_score = 0, endgame_score = 0;
+	};
+	std::vector<Entry> entries;
+	unsigned long long probes = 0, hits = 0;
+public:
+	PawnHashTable(const size_t &entry_count = PAWN_HASH_ENTRIES) noexcept;
+	bool Probe(const uint64_t &key, float &middlegame_score, float &endgame_score) noexcept;
+	void Store(const uint64_t &key, const float &middlegame_score, const float &endgame_score) noexcept;
+	unsigned long long GetProbes() const noexcept;
+	unsigned long long GetHits() const noexcept;
+	void ResetCounters() noexcept;
+};
+
+// evaluation cache class declaration, a hash table of static evaluations indexed by zobrist keys that the search threads share without locking,
+// an entry stores its key xored with its data so an entry torn by two threads writing it at once fails the check instead of giving a wrong score
+class EvaluationCache {
+private:
+	struct Entry {
+		std::atomic<uint64_t> check{0};		// the zobrist key xored with the data
+		std::atomic<uint64_t> data{0};		// the bits of the score in the lower half, bit 32 set if the entry is not empty
+	};
+	std::unique_ptr<Entry[]> entries;
+	size_t entry_count = 0;					// always a power of two
+public:
+	EvaluationCache(const size_t &entry_count = EVAL_CACHE_ENTRIES) noexcept;
+	bool Probe(const uint64_t &key, float &score) const noexcept;
+	void Store(const uint64_t &key, const float &score) noexcept;
+	void Clear() noexcept;
+};
+
+// the hidden layer sums of a neural network for both teams' perspectives, see "NeuralNetwork"
+struct Accumulator {
+	int16_t values[2][NNUE_MAX_HIDDEN];		// [is_white perspective][hidden neuron]
+};
+
+// neural network class declaration, an efficiently updatable evaluation network: each team's perspective sees 768 inputs, one for every
+// (own or enemy, PieceTypes, square) with the squares counted from a1 of its own side, which feed a hidden layer whose sums (the accumulator)
+// are kept in every position and updated by adding or subtracting one weight column as a piece comes or goes, the hidden values of the side
+// to move and of the other side are clipped to [0, 255] and feed the single output, whose weights are scaled by 64,
+// the file holds "CBNN", the version (1) and the hidden layer size as 32-bit numbers, then the 16-bit hidden biases, the 16-bit hidden weights
+// feature by feature, the 8-bit output weights with the side to move's half first and the 32-bit output bias, all of them little-endian
+class NeuralNetwork {
+private:
+	unsigned short hidden_size = 0;			// a multiple of 16 up to "NNUE_MAX_HIDDEN", zero until a network is loaded
+	std::vector<int16_t> hidden_biases;		// [hidden neuron]
+	std::vector<int16_t> hidden_weights;	// [feature][hidden neuron]
+	std::vector<int8_t> output_weights;		// [2 * hidden neuron], the side to move's half first
+	int32_t output_bias = 0;
+	static unsigned short FeatureIndex(const bool &perspective, const char &piece, const short &square) noexcept;
+public:
+	bool Load(const std::string &path) noexcept;
+	unsigned short GetHiddenSize() const noexcept;
+	void Refresh(Accumulator &accumulator, const char board[BOARD_SIZE][BOARD_SIZE]) const noexcept;
+	void Refresh(Accumulator &accumulator, const char board[BOARD_SIZE][BOARD_SIZE], const EvaluationKernels &kernel) const noexcept;
+	void AddPiece(Accumulator &accumulator, const char &piece, const short &square) const noexcept;
+	void RemovePiece(Accumulator &accumulator, const char &piece, const short &square) const noexcept;
+	int Evaluate(const Accumulator &accumulator, const bool &perspective) const noexcept;
+	int Evaluate(const Accumulator &accumulator, const bool &perspective, const EvaluationKernels &kernel) const noexcept;
+};
+
+// limits of a search, zero means there is no limit
+struct SearchLimits {
+	double max_time = 0;					// in seconds
+	unsigned long long max_nodes = 0;
+	unsigned short max_depth = 0;			// in plies
+	bool infinite = false;					// if true the limits above are ignored and the search goes on until it is stopped
+};
+
+// the result of a completed iteration of the search
+struct SearchReport {
+	unsigned short depth = 0;
+	float score = 0;						// from the point of view of the player whose turn it is
+	unsigned long long nodes = 0;			// visited by all threads
+	unsigned long long eval_cache_hits = 0, eval_cache_misses = 0;		// of the main thread
+	double time = 0;						// in seconds
+	MoveList principal_variation;			// the best move and the expected replies, as far as the transposition table remembers them
+};
+
+// the state of a running search, shared by every node of the search tree
+struct SearchInfo {
+	SearchLimits limits;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::atomic<bool> *stop = nullptr;		// set from outside to stop the search
+	std::atomic<unsigned long long> nodes{0};		// only written by the thread of the search, atomic so the main thread can add it to its reports
+	const std::vector<SearchInfo> *helpers = nullptr;		// the main thread's view of the helper threads' searches, their nodes are counted in its reports
+	unsigned short completed_depth = 0;		// the depth of the last iteration that completed
+	unsigned short thread_index = 0;		// 0 for the main thread, odd numbered helper threads start one ply deeper so the threads spread over different depths
+	bool stopped = false;					// if true the running iteration is abandoned
+	bool has_root_move = false;				// true once a root move has been searched, the main thread cannot be stopped before that
+	std::function<void(const SearchReport&)> report;		// called after every completed iteration if it is set
+	const Tablebases *tablebases = nullptr;	// probed at every node below the root if it is set
+	PawnHashTable *pawn_table = nullptr;	// the search thread's own pawn hash table, the pawn structure is computed at every evaluation if it is not set
+	EvaluationCache *eval_cache = nullptr;	// the bot's evaluation cache, every position is evaluated if it is not set
+	unsigned long long eval_cache_hits = 0, eval_cache_misses = 0;
+	Move killers[MAX_SEARCH_DEPTH+1][2];	// the last two quiet moves that caused a beta cutoff at each ply
+	int history[2][BOARD_SIZE*BOARD_SIZE][BOARD_SIZE*BOARD_SIZE] = {};		// [is_white][from][to], how often each quiet move caused a beta cutoff, weighted by depth
+	double ElapsedTime() const noexcept;
+	void CountNode() noexcept;
+	float Evaluate(const Chess &c) noexcept;
+	void UpdateQuietCutoff(const Move &move, const bool &white, const unsigned short &ply, const unsigned short &depth) noexcept;
+};
+
+// path node class declaration, one ply of the search stack
+class PathNode {
+private:
+	MoveList moves;			// the moves of the position searched at this ply, in the order they are searched
+	void CreateMoveList(Chess &c, const SearchInfo &info, const unsigned short &ply, const Move &tt_move) noexcept;
+	float Quiescence(Chess &c, SearchInfo &info, const unsigned short &ply, float alpha, const float &beta) noexcept;
+	float AlphaBeta(Chess &c, TranspositionTable &tt, SearchInfo &info, const unsigned short &depth, const unsigned short &ply, float alpha, float beta) noexcept;
+	bool AlphaBetaRoot(Chess &c, TranspositionTable &tt, SearchInfo &info, const unsigned short &depth, Move &best_move, float &best_score) noexcept;
+	static void PrincipalVariation(Chess &c, const TranspositionTable &tt, const Move &best_move, MoveList &pv) noexcept;
+public:
+	Move IterativeDeepening(Chess &c, TranspositionTable &tt, SearchInfo &info) noexcept;
+};
+
+// the nodes of all plies of a search, "MAX_PLY" nodes long, the search of each ply uses the node after it for the next ply
+typedef std::vector<PathNode> SearchStack;
+
+// bot class declaration, which inherits from player class
+class Bot : public Player {
+private:
+	unsigned short difficulty;		// the depth of the bot's decision tree
+	std::shared_ptr<TranspositionTable> tt;		// kept between moves, copies of the bot share it, allocated on first use
+	std::shared_ptr<std::vector<SearchStack>> search_stacks = std::make_shared<std::vector<SearchStack>>();		// one for each search thread, reused by every search, copies of the bot share them
+	std::shared_ptr<EvaluationCache> eval_cache;		// kept between moves, copies of the bot share it, allocated on first use
+	std::shared_ptr<std::vector<PawnHashTable>> pawn_tables = std::make_shared<std::vector<PawnHashTable>>();	// one for each search thread, kept between searches, copies of the bot share them
+	std::shared_ptr<std::atomic<bool>> stop = std::make_shared<std::atomic<bool>>(false);		// stops the running search, copies of the bot share it
+	unsigned short threads = BOT_THREADS;	// number of threads the bot searches with
+	double move_time = BOT_MOVE_TIME;		// if not zero, the bot searches for this many seconds per move instead of searching as deep as its difficulty
+	std::function<void(const SearchReport&)> report;		// called by the main search thread after every completed iteration if it is set
+	std::shared_ptr<const OpeningBook> book;		// if set, the bot plays the book's moves instead of searching while the game is in the book
+	unsigned short book_depth = BOOK_DEPTH;	// the number of halfmoves of the game the book is used for
+	std::shared_ptr<const Tablebases> tablebases;		// if set, positions with few pieces are looked up instead of searched
+	std::shared_ptr<const NeuralNetwork> network;		// if set, positions are evaluated with this network instead of the piece-square tables
+	unsigned long long nodes = 0;			// number of nodes the last search visited in all threads
+	unsigned long long pawn_hash_probes = 0, pawn_hash_hits = 0;		// of the last search in all threads
+	unsigned long long eval_cache_hits = 0, eval_cache_misses = 0;		// of the last search in all threads
+	void ReportRootMove(const Move &move, const float &score) const noexcept;
+public:
+	Bot(const std::string &name, const unsigned short &difficulty) noexcept;
+	unsigned short GetDifficulty() const noexcept;
+	Move GetIdealMove(Chess &c) noexcept;
+	Move GetIdealMove(Chess &c, unsigned short difficulty) noexcept;
+	Move GetIdealMove(Chess &c, const SearchLimits &limits) noexcept;
+	void Stop() noexcept;
+	void ResetStop() noexcept;
+	unsigned short GetThreads() const noexcept;
+	void SetThreads(const unsigned short &thread_count) noexcept;
+	double GetMoveTime() const noexcept;
+	void SetMoveTime(const double &seconds) noexcept;
+	void SetReport(const std::function<void(const SearchReport&)> &function) noexcept;
+	void SetBook(const std::shared_ptr<const OpeningBook> &opening_book, const unsigned short &depth = BOOK_DEPTH) noexcept;
+	void SetTablebases(const std::shared_ptr<const Tablebases> &endgame_tablebases) noexcept;
+	void SetNetwork(const std::shared_ptr<const NeuralNetwork> &neural_network) noexcept;
+	unsigned long long GetNodes() const noexcept;
+	double GetPawnHashHitRate() const noexcept;
+	unsigned long long GetEvalCacheHits() const noexcept;
+	unsigned long long GetEvalCacheMisses() const noexcept;
+	EvaluationCache& GetEvaluationCache() noexcept;
+	TranspositionTable& GetTranspositionTable() noexcept;
+	bool operator== (const Bot &b) const noexcept;
+};
+
+// the state a move changes that cannot be recomputed from the move itself, saved before each move so "MovePieceBack" can restore it at once
+struct UndoInfo {
+	uint64_t key;							// the zobrist key of the position before the move
+	uint64_t pawn_key;						// the zobrist key of the pawns before the move
+	float middlegame_score, endgame_score;	// the incremental evaluation before the move
+	short game_phase;
+	short en_passant;						// the en passant square before the move, -1 if there was none
+	unsigned short halfmove_clock;			// the halfmove clock before the move
+	unsigned char castling_rights;			// the castling rights before the move, see "CastlingRights"
+	char captured;							// the piece captured on the target square, "EMPTY" for quiet moves and en passant
+};
+
+// a position reduced to what its static evaluation with the piece-square tables needs, see "Chess::EvaluateBoards"
+struct PackedBoard {
+	Bitboard pieces[2][6];					// [is_white][PieceTypes]
+	uint64_t pawn_key;						// the zobrist key of the pawns, looks up the pawn structure scores in a pawn hash table
+	bool whites_turn;
+};
+
+// chess class declaration
+class Chess {
+private:
+	char board[BOARD_SIZE][BOARD_SIZE];		// game board, kept in sync with the bitboards so the piece on a square can be looked up directly
+	Bitboard pieces[2][6] = {};				// one bitboard for each color and piece type, [is_white][PieceTypes]
+	Bitboard occupancy[2] = {};				// all squares occupied by each color, [is_white]
+	Bitboard all_pieces = 0;				// all occupied squares
+	Bot white, black;						// teams
+	std::vector<std::pair<Moves, std::string>> all_game_moves;		// a record which contains all the moves played throughout the game in chronological order
+	std::vector<UndoInfo> undo_stack;		// one record for each move made since the position was set up, both the game's moves and the search's
+	uint64_t key = 0;						// the zobrist key of the current position, updated incrementally
+	uint64_t pawn_key = 0;					// the zobrist key of the pawns alone, updated incrementally, see "PawnHashTable"
+	bool whites_turn = true;				// if true then it's team white's turn, if false then it's team black's turn
+	unsigned char castling_rights = ALL_CASTLING_RIGHTS;		// the sides each team can still castle to, see "CastlingRights"
+	short en_passant = -1;					// the square a pawn can move to by capturing en passant, -1 if there is no such square
+	float middlegame_score = 0, endgame_score = 0;		// material plus position worth of all pieces from team white's point of view, updated incrementally
+	short game_phase = 0;					// how much non-pawn material is on the board, "MAX_GAME_PHASE" at the start of the game
+	unsigned short halfmove_clock = 0;		// number of halfmoves played after a pawn moved or a capture happened
+	unsigned short start_ply = 0;			// number of halfmoves played before the position was set up, see "GetFullmoveNumber"
+	uint64_t random_state = 0x2545F4914F6CDD1DULL;		// the state of the game's own random number generator, see "SeedRandom"
+	std::shared_ptr<const NeuralNetwork> network;		// if set, the position is evaluated with this network instead of the piece-square tables
+	Accumulator accumulator = {};			// the network's hidden layer sums of the position, updated incrementally while "network" is set
+	static std::string ToString(const short &x1, const short &y1, const short &x2, const short &y2) noexcept;
+	static void AddMoves(MoveList &all_moves, const short &from, Bitboard targets, const MoveFlags &flags) noexcept;
+	static void AddPawnMoves(MoveList &all_moves, const short &from, Bitboard targets, const MoveFlags &flags) noexcept;
+	Bot& GetCurrentPlayer() noexcept;
+	void ChangeTurn() noexcept;
+	void PutPiece(const short &x, const short &y, const char &piece) noexcept;
+	void RemovePiece(const short &x, const short &y) noexcept;
+	void PlacePiece(const short &x, const short &y, const char &piece) noexcept;
+	void ClearSquare(const short &x, const short &y) noexcept;
+	void LoadBoard(const char new_board[BOARD_SIZE][BOARD_SIZE]) noexcept;
+	uint64_t EnPassantKey() const noexcept;
+	uint64_t ComputeKey() const noexcept;
+	void ComputeEvaluation(float &full_middlegame_score, float &full_endgame_score, short &full_game_phase) const noexcept;
+	static void EvaluatePawns(const Bitboard (&pieces)[2][6], float &pawn_middlegame_score, float &pawn_endgame_score) noexcept;
+	static float EvaluatePawnShield(const Bitboard (&pieces)[2][6], const bool &white) noexcept;
+	static float BlendEvaluation(const Bitboard (&pieces)[2][6], const uint64_t &pawn_key, const bool &turn, const float &material_middlegame_score, const float &material_endgame_score, const short &material_game_phase, PawnHashTable *pawn_table) noexcept;
+	Bitboard AttackersOf(const short &square, const bool &by_white, const Bitboard &occupied) const noexcept;
+	static Bitboard AttackersOf(const Bitboard (&attackers)[6], const short &square, const bool &by_white, const Bitboard &occupied) noexcept;
+	bool IsSquareAttacked(const short &square, const bool &by_white) const noexcept;
+	void AppendToAllGameMoves(const Move &move) noexcept;
+	void PawnMoves(MoveList &all_moves, const short &x, const short &y, const Bitboard &allowed, const bool &captures_only) const noexcept;
+	void RookMoves(MoveList &all_moves, const short &x, const short &y, const Bitboard &allowed, const bool &captures_only) const noexcept;
+	void KnightMoves(MoveList &all_moves, const short &x, const short &y, const Bitboard &allowed, const bool &captures_only) const noexcept;
+	void BishopMoves(MoveList &all_moves, const short &x, const short &y, const Bitboard &allowed, const bool &captures_only) const noexcept;
+	void QueenMoves(MoveList &all_moves, const short &x, const short &y, const Bitboard &allowed, const bool &captures_only) const noexcept;
+	void KingMoves(MoveList &all_moves, const short &x, const short &y, const bool &in_check, const bool &captures_only) const noexcept;
+	void EnPassantMoves(MoveList &all_moves, const short &king_square, const Bitboard &check_mask) const noexcept;
+	Bitboard PinnedPieces(const short &king_square) const noexcept;
+public:
+	Chess(const std::string &player1, const unsigned short &difficulty1, const std::string &player2, const unsigned short &difficulty2) noexcept;
+	void Reset() noexcept;
+	bool LoadFEN(const std::string &fen) noexcept;
+	std::string GetFEN() const noexcept;
+	unsigned short GetHalfmoveClock() const noexcept;
+	unsigned short GetFullmoveNumber() const noexcept;
+	static bool WithinBounds(const short &coord) noexcept;
+	static short PieceType(const char &piece) noexcept;
+	static float EvaluatePiece(const char &piece) noexcept;
+	char GetPiece(const short &x, const short &y) const noexcept;
+	bool GetTurn() const noexcept;
+	Bot& GetPlayer(const bool &white) noexcept;
+	const Bot& GetPlayer(const bool &white) const noexcept;
+	const std::vector<std::pair<Moves, std::string>>& GetAllGameMoves() const noexcept;
+	Bitboard GetPieces(const bool &white, const short &type) const noexcept;
+	unsigned char GetCastlingRights() const noexcept;
+	short GetEnPassant() const noexcept;
+	bool IsCheck(const bool &turn) const noexcept;
+	uint64_t GetKey() const noexcept;
+	bool IsRepetition(const unsigned short &times) const noexcept;
+	Move ParseMove(const std::string &text) noexcept;
+	static Move FindMove(const short &from, const short &to, const char &promotion, const MoveList &all_moves) noexcept;
+	void SeedRandom(const uint64_t &seed) noexcept;
+	void SetBook(const std::shared_ptr<const OpeningBook> &book, const unsigned short &depth = BOOK_DEPTH) noexcept;
+	void SetTablebases(const std::shared_ptr<const Tablebases> &tablebases) noexcept;
+	void SetNetwork(const std::shared_ptr<const NeuralNetwork> &network) noexcept;
+	void UseNetwork(const std::shared_ptr<const NeuralNetwork> &neural_network) noexcept;
+	uint64_t NextRandom() noexcept;
+	template<class T> T GetRandomNumber(const T &min, const T &max) noexcept;
+	void AllMoves(MoveList &all_moves, const bool &captures_only = false) noexcept;
+	Move GetRandomMove() noexcept;
+	void ReserveMoves(const size_t &moves) noexcept;
+	void PlayMove(const Move &move) noexcept;
+	void MovePiece(const Move &move) noexcept;
+	void MovePieceBack(const Move &move) noexcept;
+	float EvaluateBoard(const bool &turn, PawnHashTable *pawn_table = nullptr) const noexcept;
+	PackedBoard GetPackedBoard() const noexcept;
+	static void EvaluateBoards(const std::vector<PackedBoard> &boards, std::vector<float> &scores, PawnHashTable *pawn_table = nullptr) noexcept;
+	static void EvaluateBoards(const std::vector<PackedBoard> &boards, std::vector<float> &scores, const EvaluationKernels &kernel, PawnHashTable *pawn_table = nullptr) noexcept;
+	static EvaluationKernels GetEvaluationKernel() noexcept;
+	static bool EvaluationSelfCheck(const unsigned long &games, const std::shared_ptr<const NeuralNetwork> &network = nullptr) noexcept;
+	unsigned long long Perft(const unsigned short &depth) noexcept;
+	unsigned long long PerftRoot(const unsigned short &depth, const unsigned short &threads, const bool &divide) noexcept;
+	static bool FenSelfCheck() noexcept;
+	static bool PerftSuite(const unsigned short &threads) noexcept;
+	static bool PerftFile(const std::string &path, const unsigned short &threads) noexcept;
+};
+
+// a position read from an EPD file
+struct EpdRecord {
+	std::string fen;						// the position as a full FEN string, the move clocks are taken from the "hmvc" and "fmvn" operations if the line has none
+	std::string operations;					// the rest of the line, e.g. "bm Nf3; id \"position 1\";"
+	unsigned long long line_number = 0;		// the line of the file the position is on, counting from 1
+	std::string GetOperation(const std::string &opcode) const noexcept;
+};
+
+// EPD reader class declaration, reads the positions of an EPD (or FEN) file one line at a time so files of any size can be read with little memory
+class EpdReader {
+private:
+	std::ifstream file;
+	std::string line;						// the last line read, its memory is reused for every line
+	unsigned long long line_number = 0;
+public:
+	EpdReader(const std::string &path) noexcept;
+	bool IsOpen() const noexcept;
+	bool Next(EpdRecord &record) noexcept;
+};
+
+// memory-mapped file class declaration, maps a whole file read-only so the operating system loads its pages as they are read
+// and shares them between the processes that map the same file
+class MappedFile {
+private:
+	const unsigned char *data = nullptr;
+	size_t size = 0;						// in bytes
+public:
+	MappedFile() noexcept = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator= (const MappedFile&) = delete;
+	~MappedFile() noexcept;
+	bool Open(const std::string &path) noexcept;
+	void Close() noexcept;
+	const unsigned char* GetData() const noexcept;
+	size_t GetSize() const noexcept;
+};
+
+// opening book class declaration, a read-only memory-mapped Polyglot book: 16-byte entries (big-endian key, move, weight and learn) sorted
+// by the Polyglot key of the position, so books made by other programs can be read and the books made with "Build" can be used by them
+class OpeningBook {
+private:
+	MappedFile file;
+	size_t entry_count = 0;
+	uint64_t EntryKey(const size_t &i) const noexcept;
+	static uint64_t ReadBigEndian(const unsigned char *bytes, const unsigned short &size) noexcept;
+	static void WriteBigEndian(std::ostream &out, const uint64_t &value, const unsigned short &size) noexcept;
+public:
+	static const size_t ENTRY_SIZE = 16;
+	OpeningBook() noexcept = default;
+	OpeningBook(const std::string &path) noexcept;
+	OpeningBook(const OpeningBook&) = delete;
+	OpeningBook& operator= (const OpeningBook&) = delete;
+	~OpeningBook() noexcept;
+	bool Open(const std::string &path) noexcept;
+	void Close() noexcept;
+	bool IsOpen() const noexcept;
+	size_t Size() const noexcept;
+	Move Probe(Chess &c) const noexcept;
+	static uint64_t PolyglotKey(const Chess &c) noexcept;
+	static unsigned short EncodeMove(const Move &move) noexcept;
+	static bool Build(const std::string &games_path, const std::string &book_path, const unsigned short &depth) noexcept;
+};
+
+// endgame tablebases class declaration, holds the result and the distance to mate of every position of endings with at most "TABLEBASE_PIECES"
+// pieces, one table for each set of pieces (e.g. "KQK" or "KRKN", the white pieces first), the tables are made by retrograde analysis with "Generate"
+// and saved as files of one byte per position, which are read back by memory-mapping them
+class Tablebases {
+private:
+	struct Position {						// a position of a table, the pieces in the order of the table's pieces
+		char pieces[TABLEBASE_PIECES];		// see "ChessPieces"
+		short squares[TABLEBASE_PIECES];
+		short count = 0;
+		bool white_to_move = true;
+	};
+	struct Table {
+		std::string name;
+		char pieces[TABLEBASE_PIECES];		// white king, black king, then the other white and black pieces from the most to the least valuable
+		short count = 0;
+		bool pawns = false;					// tables with pawns are only mirrored left to right, the others also up to down and along the diagonal
+		size_t size = 0;					// the number of positions
+		MappedFile file;
+		std::vector<unsigned char> generated;		// the values of a table made in this run, a mapped table's are in its file
+		const unsigned char *values = nullptr;		// zero for draws and illegal positions, otherwise one plus the distance to mate in plies, odd distances are wins
+	};
+	std::map<unsigned, Table> tables;		// [material key], the key of the table's material with white being the stronger side
+	unsigned short max_pieces = 0;
+	static unsigned MaterialKey(const Position &position) noexcept;
+	static unsigned FlippedMaterialKey(const unsigned &key) noexcept;
+	static unsigned CanonicalMaterialKey(const unsigned &key) noexcept;
+	static bool ParseName(const std::string &name, unsigned &key) noexcept;
+	static std::string TableName(const unsigned &key) noexcept;
+	static void SetUpTable(const unsigned &key, Table &table) noexcept;
+	static Bitboard Occupancy(const Position &position) noexcept;
+	static bool IsAttacked(const Position &position, const short &square, const bool &by_white) noexcept;
+	static bool IsValid(const Position &position) noexcept;
+	static void AllMoves(const Position &position, std::vector<Position> &children) noexcept;
+	static void Predecessors(const Position &position, std::vector<Position> &parents) noexcept;
+	static size_t Index(const Table &table, const Position &position) noexcept;
+	static bool Decode(const Table &table, const size_t &index, Position &position) noexcept;
+	const Table* FindTable(Position &position) const noexcept;
+	bool ProbeValue(Position position, unsigned char &value) const noexcept;
+	bool AddTable(const unsigned &key, const std::string &directory, const unsigned short &threads, const std::function<void(const std::string&)> &progress) noexcept;
+	void GenerateTable(Table &table, const unsigned short &threads) const noexcept;
+public:
+	Tablebases() noexcept = default;
+	Tablebases(const Tablebases&) = delete;
+	Tablebases& operator= (const Tablebases&) = delete;
+	unsigned short Load(const std::string &directory) noexcept;
+	bool Generate(const std::string &name, const std::string &directory, const unsigned short &threads, const std::function<void(const std::string&)> &progress = nullptr) noexcept;
+	unsigned short GetMaxPieces() const noexcept;
+	bool Probe(const Chess &c, float &score) const noexcept;
+};
+
+// a position to analyze in a batch
+struct BatchJob {
+	unsigned long long index = 0;			// the position's place in the input, counting from 0
+	std::string fen;
+	SearchLimits limits;
+	std::string tag;						// handed back in the result unchanged, e.g. the name of the position
+};
+
+// the analysis of a position of a batch
+struct BatchResult {
+	unsigned long long index = 0;			// the index of the job
+	std::string fen, tag;					// the FEN and the tag of the job
+	bool valid = false;						// false if the job's FEN could not be loaded, the fields below are meaningless then
+	Move best_move;							// a null move if the player has no moves
+	float score = 0;						// from the point of view of the player whose turn it is
+	unsigned short depth = 0;				// the depth of the last completed iteration
+	unsigned long long nodes = 0;
+	double time = 0;						// in seconds
+};
+
+// batch analyzer class declaration, analyzes a stream of positions on a pool of worker threads, each with its own game and bot
+class BatchAnalyzer {
+private:
+	unsigned short threads;					// number of worker threads, each one searches one position at a time with a single thread
+	size_t hash_megabytes;					// size of each worker's transposition table
+	bool ordered;							// if true the results are handed out in the order of the input, otherwise as soon as they are ready
+public:
+	BatchAnalyzer(const unsigned short &threads, const size_t &hash_megabytes = HASH_SIZE_MB, const bool &ordered = true) noexcept;
+	unsigned long long Run(const std::function<bool(BatchJob&)> &next_job, const std::function<void(const BatchResult&)> &result) noexcept;
+};
+
+// the settings of a bot playing in a match
+struct MatchPlayer {
+	SearchLimits limits;					// the limits of every search, a move time is spent on every move regardless of the clock
+	size_t hash_megabytes = HASH_SIZE_MB;
+	unsigned short threads = 1;				// search threads of the bot, the match runs several games at once so one is usually best
+	std::shared_ptr<const NeuralNetwork> network;		// the bot evaluates with the piece-square tables if it is not set
+};
+
+// the settings of a sequential probability ratio test (SPRT), which tells apart "the first player is elo0 stronger" (H0) from
+// "the first player is elo1 stronger" (H1) with the given error rates, the match stops as soon as one of them is accepted
+struct SprtSettings {
+	bool enabled = false;
+	double elo0 = 0, elo1 = 5;
+	double alpha = 0.05, beta = 0.05;		// the chances of accepting H1 when H0 is true and of accepting H0 when H1 is true
+	double LowerBound() const noexcept;
+	double UpperBound() const noexcept;
+};
+
+// the results of a match from the first player's point of view
+struct MatchScore {
+	unsigned long long wins = 0, draws = 0, losses = 0;
+	unsigned long long Games() const noexcept;
+	double Score() const noexcept;
+	double EloDifference() const noexcept;
+	double EloError() const noexcept;
+	double LikelihoodOfSuperiority() const noexcept;
+	double LogLikelihoodRatio(const double &elo0, const double &elo1) const noexcept;
+};
+
+// match runner class declaration, plays games between two bots on a pool of threads, every opening is played twice with the colors swapped
+class MatchRunner {
+private:
+	MatchPlayer players[2];
+	std::vector<std::string> openings;		// the FEN strings of the starting positions of the games
+	unsigned short threads;					// number of games played at once
+	static short PlayGame(Chess &c, Bot &white, const MatchPlayer &white_player, Bot &black, const MatchPlayer &black_player) noexcept;
+public:
+	MatchRunner(const MatchPlayer &first, const MatchPlayer &second, const std::vector<std::string> &openings, const unsigned short &threads) noexcept;
+	MatchScore Run(const unsigned long long &games, const SprtSettings &sprt, const std::function<void(const MatchScore&)> &progress) noexcept;
+};
+
+// other function declarations
+bool InitBitboards() noexcept;
+bool InitZobrist() noexcept;
+unsigned long long GetAllocationCount() noexcept;
+std::string ToLowerString(std::string s) noexcept;
+
+// console front end function declarations, defined in console.cpp, which is not part of the engine library
+void MoveCursorToXY(const short &x, const short &y) noexcept;
+void PrintBoard(const Chess &c) noexcept;
+bool PlayersTurn(Chess &c) noexcept;
+bool BotsTurn(Chess &c) noexcept;
+bool GameOver(Chess &c) noexcept;
+
+// returns a random number between "min" and "max" from the game's own random number generator
+template<class T> T Chess::GetRandomNumber(const T &min, const T &max) noexcept {
+	return min + T(NextRandom() % static_cast<uint64_t>(max-min+1));
+}
+
+#endif			//CHESS_H
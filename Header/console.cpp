@@ -0,0 +1,323 @@
+#include "chess.h"
+#include <iostream>
+#include <algorithm>
+#include <cstdio>
+#ifdef _WIN32
+#include <conio.h>
+#include <windows.h>
+#else
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+// console front end implementation, the only part of the program that reads from or writes to the terminal,
+// the engine library is built from the rest of the files in this directory and never calls any of these
+
+// function definitions
+
+// reads a single key press from the terminal without waiting for the enter key
+static int ReadKey() noexcept {
+#ifdef _WIN32
+	return getch();
+#else
+	termios old_settings, new_settings;
+	tcgetattr(STDIN_FILENO, &old_settings);
+	new_settings = old_settings;
+	new_settings.c_lflag &= ~(ICANON | ECHO);
+	tcsetattr(STDIN_FILENO, TCSANOW, &new_settings);
+	const int &key = getchar();
+	tcsetattr(STDIN_FILENO, TCSANOW, &old_settings);
+	return key;
+#endif
+}
+
+// clears the terminal
+static void ClearScreen() noexcept {
+#ifdef _WIN32
+	system("cls");
+#else
+	std::cout << "\033[2J\033[H" << std::flush;
+#endif
+}
+
+// moves the cursor to a different (x, y) location on the terminal
+void MoveCursorToXY(const short &x, const short &y) noexcept {
+#ifdef _WIN32
+	SetConsoleCursorPosition(GetStdHandle(STD_OUTPUT_HANDLE), (COORD){x, y});
+#else
+	std::cout << "\033[" << y+1 << ";" << x+1 << "H" << std::flush;
+#endif
+}
+
+
+
+// console game implementation, the game is shown and played through the public interface of the chess class
+
+// changes the given board coordinates from ASCII to numerical, e.g. ('d', '3') -> (3, 5)
+static void ChangeToRealCoordinates(char &x1, char &y1, char &x2, char &y2) noexcept {
+	x1 -= 'a', x2 -= 'a';
+	y1 = '8'-y1, y2 = '8'-y2;
+}
+
+// returns the name that is displayed on the terminal for the given piece
+static std::string PieceNameToString(const char &piece) noexcept {
+	switch(piece) {
+		case W_PAWN:	return "W_PAWN";
+		case B_PAWN:	return "B_PAWN";
+		case W_ROOK:	return "W_ROOK";
+		case B_ROOK:	return "B_ROOK";
+		case W_KNIGHT:	return "W_KNIGHT";
+		case B_KNIGHT:	return "B_KNIGHT";
+		case W_BISHOP:	return "W_BISHOP";
+		case B_BISHOP:	return "B_BISHOP";
+		case W_QUEEN:	return "W_QUEEN";
+		case B_QUEEN:	return "B_QUEEN";
+		case W_KING:	return "W_KING";
+		case B_KING:	return "B_KING";
+		default:		return "";
+	}
+}
+
+// clears all available moves from the terminal
+static void ClearAllMoves(const unsigned short &n) noexcept {
+	MoveCursorToXY(0, DOWN + 3*BOARD_SIZE + 9);
+	for(unsigned short i=0;i<n;++i)
+		std::cout << CLEAR_LINE << std::endl;
+}
+
+// prints the vertical seperators for the game board on the terminal
+static void PrintSeparator(const char &ch) noexcept {
+	for(unsigned short i=1;i<BOARD_SIZE;++i)
+		std::cout << std::string(BOX_WIDTH, ch) << "|";
+	std::cout << std::string(BOX_WIDTH, ch) << std::endl << TO_RIGHT;
+}
+
+// prints game over message to the terminal
+static bool EndGameText(const Chess &c, const unsigned short &n, const Endgame &end_game) noexcept {
+	ClearAllMoves(n);
+	MoveCursorToXY(RIGHT, DOWN + 3*BOARD_SIZE + 7);
+	switch(end_game) {
+		case CHECKMATE:
+			std::cout << "!!!Checkmate!!!" << CLEAR_LINE << std::endl << TO_RIGHT << c.GetPlayer(!c.GetTurn()).GetName() << " wins!";
+			return true;
+		default:
+			std::cout << "!!!Draw!!!" << CLEAR_LINE << std::endl << TO_RIGHT;
+			switch(end_game) {
+				case FIFTY_MOVES:
+					std::cout << "Fifty-move rule: No capture has been made and no pawn has been moved in the last 50 moves.";
+					return true;
+				case THREEFOLD_REP:
+					std::cout << "Threefold repetition: Last position occured 3 times during the game.";
+					return true;
+				default:
+					return false;
+			}
+	}
+}
+
+// asks the player it's choice of promotion, then returns the desired piece as team white's piece
+static char ManuallyPromotePawn() noexcept {
+	MoveCursorToXY(RIGHT, DOWN + 3*BOARD_SIZE + 7);
+	std::cout << "Enter your choice of promotion [(r)ook, (k)night, (b)ishop, (q)ueen]";
+	char key = ReadKey();
+	while(true)
+		switch(key = tolower(key)) {
+			case 'r':	return W_ROOK;
+			case 'k':	return W_KNIGHT;
+			case 'b':	return W_BISHOP;
+			case 'q':	return W_QUEEN;
+			default:	key = ReadKey();
+		}
+}
+
+// updates the board display on the terminal
+static void UpdateBoard(const Chess &c, const short &x, const short &y) noexcept {
+	const unsigned short &diff = BOX_WIDTH - PieceNameToString(c.GetPiece(x, y)).length();
+	MoveCursorToXY(RIGHT + (BOX_WIDTH+1)*x, DOWN + 3*y + 1);
+	std::cout << std::string(diff/2, ' ') << PieceNameToString(c.GetPiece(x, y)) << std::string(diff/2, ' ');
+	if(diff%2)	std::cout << " ";
+}
+
+// updates the score display of the given team on the terminal
+static void UpdateScore(const Chess &c, const bool &white) noexcept {
+	const Bot &p = c.GetPlayer(white);
+	const unsigned short &dx = white ? p.GetName().length() + 2 : (BOX_WIDTH+1)*BOARD_SIZE - 5;
+	MoveCursorToXY(RIGHT+dx, DOWN + 3*BOARD_SIZE + 2);
+	std::cout << std::string(std::to_string(p.GetScore()).length(), ' ');
+	MoveCursorToXY(RIGHT+dx, DOWN + 3*BOARD_SIZE + 2);
+	std::cout << p.GetScore();
+}
+
+// updates the board and the score of the player who moved on the terminal after the given move is played
+static void DisplayMove(const Chess &c, const Move &move) noexcept {
+	const short &x1 = move.GetFrom()%BOARD_SIZE, &y1 = move.GetFrom()/BOARD_SIZE, &x2 = move.GetTo()%BOARD_SIZE, &y2 = move.GetTo()/BOARD_SIZE;
+	if(move.IsCapture())
+		UpdateScore(c, !c.GetTurn());
+	if(move.IsEnPassant())
+		UpdateBoard(c, x2, y1);
+	else if(move.IsCastling()) {
+		UpdateBoard(c, move.GetFlags() == QUEEN_CASTLE ? 0 : 7, y1);
+		UpdateBoard(c, move.GetFlags() == QUEEN_CASTLE ? 3 : 5, y1);
+	}
+	UpdateBoard(c, x1, y1);
+	UpdateBoard(c, x2, y2);
+}
+
+// after the game is over, prints all moves played throughout the game in chronological order
+static void PrintAllMovesMadeInOrder(const Chess &c) noexcept {
+	std::cout << std::endl << std::endl << TO_RIGHT << "All moves made in order:" << std::endl;
+	bool turn = true;
+	for(const auto &game_move : c.GetAllGameMoves()) {
+		std::cout << std::endl << TO_RIGHT << c.GetPlayer(turn).GetName() << ": ";
+		switch(game_move.first) {
+			case CASTLING:
+				std::cout << "castling " << (game_move.second[2] == 'c' ? "long" : "short");	break;
+			default:
+				std::cout << ToLowerString(PieceNameToString(game_move.second[4])).substr(2) << " '" << game_move.second.substr(0, 2) << "' to ";
+				if(game_move.second[5] != EMPTY)
+					std::cout << ToLowerString(PieceNameToString(game_move.second[5])).substr(2) + " ";
+				std::cout << "'" << game_move.second.substr(2, 2) << "'";
+				switch(game_move.first) {
+					case PROMOTION:
+						std::cout << " promoted to " << ToLowerString(PieceNameToString(game_move.second[6])).substr(2);
+						break;
+					case EN_PASSANT:
+						std::cout << " (en passant)";
+					default:
+						break;
+				}
+		}
+		turn = !turn;
+	}
+}
+
+// checks if the game is over or not
+static bool CheckEndgame(Chess &c, const unsigned short &n = 0) noexcept {
+	MoveList all_moves;
+	c.AllMoves(all_moves);
+	if(all_moves.Empty()) {			// if the opponent has no moves left, then it is checkmate
+		c.GetPlayer(!c.GetTurn()).IncreaseScore(Chess::EvaluatePiece(W_KING));
+		UpdateScore(c, !c.GetTurn());
+		return EndGameText(c, n, CHECKMATE);
+	}
+	else if(c.GetHalfmoveClock() >= 100)		// fifty moves of each team
+		return EndGameText(c, n, FIFTY_MOVES);
+	if(c.IsRepetition(3))
+		return EndGameText(c, n, THREEFOLD_REP);
+	return false;
+}
+
+// prints the game board on the terminal
+void PrintBoard(const Chess &c) noexcept {
+	const std::string &white_name = c.GetPlayer(true).GetName(), &black_name = c.GetPlayer(false).GetName();
+	std::cout << TO_DOWN << TO_RIGHT;
+	for(short y=0;y<BOARD_SIZE;++y) {
+		PrintSeparator(' ');
+		std::cout << "\b\b\b" << BOARD_SIZE-y << "  ";
+		for(short x=0;x<BOARD_SIZE;++x) {
+			const unsigned short &diff = BOX_WIDTH - PieceNameToString(c.GetPiece(x, y)).length();
+			std::cout << std::string(diff/2, ' ') << PieceNameToString(c.GetPiece(x, y)) << std::string(diff/2, ' ');
+			if(diff%2)				std::cout << " ";
+			if(x < BOARD_SIZE-1)	std::cout << "|";
+		}
+		if(y < BOARD_SIZE-1) {
+			std::cout << std::endl << TO_RIGHT;
+			PrintSeparator('_');
+		}
+	}
+	std::cout << std::endl << TO_RIGHT;
+	PrintSeparator(' ');
+	for(char ch='a';ch<'a'+BOARD_SIZE;++ch)
+		std::cout << std::string(BOX_WIDTH/2, ' ') << ch << std::string(BOX_WIDTH/2, ' ');
+	std::cout << std::endl << std::endl << TO_RIGHT << white_name << ": 0";
+	std::cout << std::string((BOX_WIDTH+1)*BOARD_SIZE - white_name.length() - black_name.length() - 10, ' ') << black_name << ": 0";
+	std::cout << std::endl << std::endl << TO_RIGHT << white_name << "'s turn...";
+	std::cout << std::endl << TO_RIGHT << "Enter move coordinates (x1,y1)->(x2,y2):";
+	std::cout << std::endl << std::endl << TO_RIGHT << "All possible moves:" << std::endl;
+}
+
+// lists all possible moves, expects player input and plays the given move if it is valid, expects a valid input otherwise
+bool PlayersTurn(Chess &c) noexcept {
+	MoveList all_moves;
+	c.AllMoves(all_moves);
+	std::sort(all_moves.begin(), all_moves.end(), [](const Move &m1, const Move &m2){ return m1.ToString() < m2.ToString(); });
+	unsigned short i=0;
+	for(const auto &move : all_moves) {
+		if(move.IsPromotion() && move.GetPromotionPiece(true) != W_QUEEN)
+			continue;					// promotions are listed once, the piece is asked after the move is entered
+		if(!((i++)%MOVES_PER_LINE))	std::cout << std::endl;
+		std::cout << TO_RIGHT << move.ToString().substr(0, 2) << " " << move.ToString().substr(2, 2);
+	}
+	if(c.IsCheck(c.GetTurn())) {
+		std::cout << std::endl << std::endl << TO_RIGHT << "Check!";
+		i += 2*MOVES_PER_LINE;
+	}
+	MoveCursorToXY(RIGHT+41, DOWN + 3*BOARD_SIZE + 5);
+	while(true) {
+		std::string from, to;
+		std::cin >> from;
+		if(!ToLowerString(from).compare("quit"))
+			return EndGameText(c, i/MOVES_PER_LINE + 1, QUIT);
+		if(!ToLowerString(from).compare("exit"))
+			return EndGameText(c, i/MOVES_PER_LINE + 1, QUIT);
+		std::cin >> to;
+		from.resize(2);
+		to.resize(2);
+		from.shrink_to_fit();
+		to.shrink_to_fit();
+		from[0] = tolower(from[0]), to[0] = tolower(to[0]);
+		ChangeToRealCoordinates(from[0], from[1], to[0], to[1]);
+		if((from[0]!=to[0] || from[1]!=to[1]) && Chess::WithinBounds(from[0]) && Chess::WithinBounds(from[1]) && Chess::WithinBounds(to[0]) && Chess::WithinBounds(to[1]))
+			if(!Chess::FindMove(from[1]*BOARD_SIZE + from[0], to[1]*BOARD_SIZE + to[0], W_QUEEN, all_moves).IsNull()) {
+				Move move = Chess::FindMove(from[1]*BOARD_SIZE + from[0], to[1]*BOARD_SIZE + to[0], W_QUEEN, all_moves);
+				if(move.IsPromotion()) {
+					move = Chess::FindMove(move.GetFrom(), move.GetTo(), ManuallyPromotePawn(), all_moves);
+					MoveCursorToXY(RIGHT, DOWN + 3*BOARD_SIZE + 7);
+					std::cout << "All possible moves:" << CLEAR_LINE;
+				}
+				c.PlayMove(move);
+				DisplayMove(c, move);
+				if(CheckEndgame(c, i/MOVES_PER_LINE + 1))
+					return false;
+				break;
+			}
+		MoveCursorToXY(RIGHT+41, DOWN + 3*BOARD_SIZE + 5);
+		std::cout << CLEAR_LINE << std::endl << CLEAR_LINE;
+		MoveCursorToXY(RIGHT+41, DOWN + 3*BOARD_SIZE + 5);
+	}
+	MoveCursorToXY(RIGHT, DOWN + 3*BOARD_SIZE + 4);
+	std::cout << c.GetPlayer(c.GetTurn()).GetName() << "'s turn..." << CLEAR_LINE;
+	MoveCursorToXY(RIGHT+41, DOWN + 3*BOARD_SIZE + 5);
+	std::cout << CLEAR_LINE << std::endl << CLEAR_LINE;
+	ClearAllMoves(i/MOVES_PER_LINE + 1);
+	MoveCursorToXY(0, DOWN + 3*BOARD_SIZE + 8);
+	return true;
+}
+
+// plays the bots move
+bool BotsTurn(Chess &c) noexcept {
+	const auto &move = (c.GetTurn() ? WHITE_BOT_RANDOM : BLACK_BOT_RANDOM) ? c.GetRandomMove() : c.GetPlayer(c.GetTurn()).GetIdealMove(c);
+	c.PlayMove(move);
+	DisplayMove(c, move);
+	if(CheckEndgame(c))
+		return false;
+	MoveCursorToXY(RIGHT, DOWN + 3*BOARD_SIZE + 4);
+	std::cout << c.GetPlayer(c.GetTurn()).GetName() << "'s turn..." << CLEAR_LINE;
+	return true;
+}
+
+// prints game over messages and expects user input for another game
+bool GameOver(Chess &c) noexcept {
+	std::cout << std::endl << std::endl << std::endl << TO_RIGHT << "Press R to play again.";
+	std::cout << std::endl << TO_RIGHT << "Press any other key to quit.";
+	PrintAllMovesMadeInOrder(c);
+	char key = ReadKey();
+	switch(key = tolower(key)) {
+		case 'r':
+			c.Reset();
+			ClearScreen();
+			return true;
+		default:
+			return false;
+	}
+}
@@ -0,0 +1,129 @@
+#include "chess.h"
+#include <cctype>
+#include <iostream>
+
+// EPD reader implementation
+
+// returns the position of the first character of the line at or after "pos" that is not a space
+static size_t SkipSpaces(const std::string &line, size_t pos) noexcept {
+	while(pos < line.length() && isspace(static_cast<unsigned char>(line[pos])))
+		++pos;
+	return pos;
+}
+
+// returns the position right after the word starting at "pos", a word ends at a space or a semicolon
+static size_t WordEnd(const std::string &line, size_t pos) noexcept {
+	while(pos < line.length() && !isspace(static_cast<unsigned char>(line[pos])) && line[pos] != ';')
+		++pos;
+	return pos;
+}
+
+// returns true if the word from "begin" to "end" is a non-negative integer
+static bool IsNumber(const std::string &line, const size_t &begin, const size_t &end) noexcept {
+	if(begin == end)
+		return false;
+	for(size_t i=begin;i<end;++i)
+		if(!isdigit(static_cast<unsigned char>(line[i])))
+			return false;
+	return true;
+}
+
+// returns the operand of the given operation without the quotes around it, or an empty string if the record has no such operation,
+// the operations are separated by semicolons and each one starts with its opcode, e.g. "bm Nf3" or ";D1 20"
+std::string EpdRecord::GetOperation(const std::string &opcode) const noexcept {
+	for(size_t begin=0;begin<operations.length();) {
+		size_t end = operations.find(';', begin);
+		if(end == std::string::npos)
+			end = operations.length();
+		const size_t &opcode_begin = SkipSpaces(operations, begin), &opcode_end = WordEnd(operations, opcode_begin);
+		if(!operations.compare(opcode_begin, opcode_end - opcode_begin, opcode)) {
+			size_t operand_begin = SkipSpaces(operations, opcode_end), operand_end = end;
+			while(operand_end > operand_begin && isspace(static_cast<unsigned char>(operations[operand_end-1])))
+				--operand_end;
+			if(operand_end - operand_begin >= 2 && operations[operand_begin] == '"' && operations[operand_end-1] == '"')
+				++operand_begin, --operand_end;
+			return operations.substr(operand_begin, operand_end - operand_begin);
+		}
+		begin = end + 1;
+	}
+	return "";
+}
+
+// constructor of EPD reader class, opens the given file
+EpdReader::EpdReader(const std::string &path) noexcept : file(path) {	}
+
+// returns true if the file could be opened
+bool EpdReader::IsOpen() const noexcept {
+	return file.is_open();
+}
+
+// reads the next position of the file into "record", empty lines and lines starting with '#' are skipped, returns false at the end of the file,
+// the record's strings keep their memory between calls so reading a position allocates nothing once they are large enough
+bool EpdReader::Next(EpdRecord &record) noexcept {
+	while(std::getline(file, line)) {
+		++line_number;
+		size_t pos = SkipSpaces(line, 0);
+		if(pos == line.length() || line[pos] == '#')
+			continue;
+		record.fen.clear();
+		for(short field=0;field<4;++field) {			// piece placement, side to move, castling rights and en passant square
+			const size_t &end = WordEnd(line, pos);
+			record.fen.append(line, pos, end - pos);
+			record.fen += ' ';
+			pos = SkipSpaces(line, end);
+		}
+		const size_t &halfmoves_end = WordEnd(line, pos), &fullmoves_begin = SkipSpaces(line, halfmoves_end), &fullmoves_end = WordEnd(line, fullmoves_begin);
+		const bool &has_clocks = IsNumber(line, pos, halfmoves_end) && IsNumber(line, fullmoves_begin, fullmoves_end);		// a FEN line
+		if(has_clocks) {
+			record.fen.append(line, pos, fullmoves_end - pos);
+			pos = fullmoves_end;
+		}
+		record.operations.assign(line, pos, std::string::npos);
+		if(!has_clocks) {
+			const std::string &halfmoves = record.GetOperation("hmvc"), &fullmoves = record.GetOperation("fmvn");
+			record.fen += (halfmoves.empty() ? "0" : halfmoves) + " " + (fullmoves.empty() ? "1" : fullmoves);
+		}
+		record.line_number = line_number;
+		return true;
+	}
+	return false;
+}
+
+
+
+// chess class FEN check implementation
+
+// checks that "LoadFEN" accepts valid positions and writes them back unchanged with "GetFEN", and that it rejects impossible positions
+// and leaves the game untouched, prints the result of each case and returns true if all of them passed
+bool Chess::FenSelfCheck() noexcept {
+	struct FenCase {
+		const char *name, *fen;
+		bool valid;
+	};
+	static const FenCase CASES[] = {
+		{"initial position", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", true},
+		{"side to move in check", "4k3/8/8/8/8/8/8/4R2K b - - 0 1", true},
+		{"check blocked", "4k3/4p3/8/8/8/8/8/4R2K w - - 0 1", true},
+		{"en passant and move clocks", "rnbqkbnr/ppp1p1pp/8/3pPp2/8/8/PPPP1PPP/RNBQKBNR w KQkq f6 0 3", true},
+		{"rook checks the side not to move", "4k3/8/8/8/8/8/8/4R2K w - - 0 1", false},
+		{"bishop checks the side not to move", "4k3/8/8/1B6/8/8/8/7K w - - 0 1", false},
+		{"knight checks the side not to move", "7k/8/8/8/8/1n6/8/K7 b - - 0 1", false},
+		{"pawn checks the side not to move", "4k3/3P4/8/8/8/8/8/7K w - - 0 1", false},
+		{"kings next to each other", "8/8/8/3kK3/8/8/8/8 w - - 0 1", false},
+		{"no white king", "4k3/8/8/8/8/8/8/8 w - - 0 1", false},
+		{"no black king", "8/8/8/8/8/8/8/4K3 b - - 0 1", false},
+		{"two white kings", "4k3/8/8/8/8/8/8/K3K3 w - - 0 1", false},
+		{"two black kings", "k3k3/8/8/8/8/8/8/4K3 w - - 0 1", false}};
+	static const char *UNTOUCHED_FEN = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+	bool all_passed = true;
+	for(const auto &fen_case : CASES) {
+		Chess c("White", 1, "Black", 1);
+		c.LoadFEN(UNTOUCHED_FEN);
+		const bool &loaded = c.LoadFEN(fen_case.fen);
+		const bool &passed = loaded == fen_case.valid && c.GetFEN() == (fen_case.valid ? fen_case.fen : UNTOUCHED_FEN);
+		std::cout << fen_case.name << ": " << (passed ? "PASS" : loaded ? "FAIL, accepted" : "FAIL, rejected") << std::endl;
+		all_passed &= passed;
+	}
+	std::cout << (all_passed ? "All FEN tests passed." : "Some FEN tests failed!") << std::endl;
+	return all_passed;
+}
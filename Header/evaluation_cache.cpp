@@ -0,0 +1,43 @@
+#include "chess.h"
+#include <cstring>
+
+// evaluation cache class implementation
+
+// constructor of evaluation cache class, the number of entries is rounded down to a power of two
+EvaluationCache::EvaluationCache(const size_t &entry_count) noexcept {
+	size_t count = 1;
+	while(2 * count <= entry_count)
+		count *= 2;
+	entries.reset(new Entry[count]);
+	this->entry_count = count;
+}
+
+// looks up the static evaluation of the given position, returns true and fills "score" if it is found, false otherwise,
+// an entry another thread is writing at the same time does not pass the xor check and counts as not found
+bool EvaluationCache::Probe(const uint64_t &key, float &score) const noexcept {
+	const Entry &entry = entries[key & (entry_count-1)];
+	const uint64_t &data = entry.data.load(std::memory_order_relaxed), &check = entry.check.load(std::memory_order_relaxed);
+	if(!(data >> 32) || (check ^ data) != key)
+		return false;
+	const uint32_t &bits = static_cast<uint32_t>(data);
+	std::memcpy(&score, &bits, sizeof(score));
+	return true;
+}
+
+// stores the static evaluation of the given position, replacing whatever was stored in its entry
+void EvaluationCache::Store(const uint64_t &key, const float &score) noexcept {
+	uint32_t bits;
+	std::memcpy(&bits, &score, sizeof(bits));
+	const uint64_t &data = (uint64_t(1) << 32) | bits;
+	Entry &entry = entries[key & (entry_count-1)];
+	entry.check.store(key ^ data, std::memory_order_relaxed);
+	entry.data.store(data, std::memory_order_relaxed);
+}
+
+// removes every entry from the cache, must not be called while a search uses it
+void EvaluationCache::Clear() noexcept {
+	for(size_t i=0;i<entry_count;++i) {
+		entries[i].check.store(0, std::memory_order_relaxed);
+		entries[i].data.store(0, std::memory_order_relaxed);
+	}
+}
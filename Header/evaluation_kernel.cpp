@@ -0,0 +1,216 @@
+#include "chess.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#if SIMD_KERNELS
+#include <immintrin.h>
+#endif
+
+// full board evaluation kernels, they sum the piece-square scores and the phase weights of all 64 squares of the board without branching,
+// the empty squares are looked up like the pieces and count zero, every score is a multiple of half a point so the sums are exact
+// in any order and every kernel gives bit-identical results to the others and to the incrementally updated scores
+
+// the scalar kernel, always available
+static void ScalarKernel(const char *board, float &middlegame_score, float &endgame_score, short &game_phase) noexcept {
+	float middlegame = 0, endgame = 0;
+	int phase = 0;
+	for(short square=0;square<BOARD_SIZE*BOARD_SIZE;++square) {
+		const short &piece = board[square] - B_KING;
+		middlegame += PIECE_SQUARE_SCORES[0][piece][square];
+		endgame += PIECE_SQUARE_SCORES[1][piece][square];
+		phase += PIECE_PHASE_WEIGHTS[piece];
+	}
+	middlegame_score = middlegame, endgame_score = endgame, game_phase = phase;
+}
+
+#if SIMD_KERNELS
+// the AVX2 kernel, eight squares at a time, the tables are gathered at (piece - B_KING) * 64 + square
+__attribute__((target("avx2"))) static void Avx2Kernel(const char *board, float &middlegame_score, float &endgame_score, short &game_phase) noexcept {
+	const __m256i &lane_squares = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	__m256 middlegame = _mm256_setzero_ps(), endgame = _mm256_setzero_ps();
+	__m256i phase = _mm256_setzero_si256();
+	for(short square=0;square<BOARD_SIZE*BOARD_SIZE;square+=8) {
+		const __m256i &pieces = _mm256_sub_epi32(_mm256_cvtepi8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(board + square))), _mm256_set1_epi32(B_KING));
+		const __m256i &indices = _mm256_add_epi32(_mm256_slli_epi32(pieces, 6), _mm256_add_epi32(lane_squares, _mm256_set1_epi32(square)));		// 64 squares per piece
+		middlegame = _mm256_add_ps(middlegame, _mm256_i32gather_ps(PIECE_SQUARE_SCORES[0][0], indices, 4));
+		endgame = _mm256_add_ps(endgame, _mm256_i32gather_ps(PIECE_SQUARE_SCORES[1][0], indices, 4));
+		phase = _mm256_add_epi32(phase, _mm256_i32gather_epi32(PIECE_PHASE_WEIGHTS, pieces, 4));
+	}
+	alignas(32) float middlegame_lanes[8], endgame_lanes[8];
+	alignas(32) int phase_lanes[8];
+	_mm256_store_ps(middlegame_lanes, middlegame);
+	_mm256_store_ps(endgame_lanes, endgame);
+	_mm256_store_si256(reinterpret_cast<__m256i*>(phase_lanes), phase);
+	float middlegame_sum = 0, endgame_sum = 0;
+	int phase_sum = 0;
+	for(short i=0;i<8;++i)
+		middlegame_sum += middlegame_lanes[i], endgame_sum += endgame_lanes[i], phase_sum += phase_lanes[i];
+	middlegame_score = middlegame_sum, endgame_score = endgame_sum, game_phase = phase_sum;
+}
+#endif
+
+// returns true if the CPU can run the given kernel, false otherwise
+static bool KernelSupported(const EvaluationKernels &kernel) noexcept {
+#if SIMD_KERNELS
+	__builtin_cpu_init();
+	switch(kernel) {
+		case SCALAR_KERNEL:	return true;
+		case SSE4_KERNEL:	return __builtin_cpu_supports("sse4.1");
+		case AVX2_KERNEL:	return __builtin_cpu_supports("avx2");
+	}
+	return false;
+#else
+	return kernel == SCALAR_KERNEL;
+#endif
+}
+
+// returns the fastest kernel the CPU can run
+static EvaluationKernels BestKernel() noexcept {
+	return KernelSupported(AVX2_KERNEL) ? AVX2_KERNEL : KernelSupported(SSE4_KERNEL) ? SSE4_KERNEL : SCALAR_KERNEL;
+}
+
+// runs the given kernel on the given board, there is no SSE4.1 kernel: without a gather instruction the table lookups stay scalar
+// and four lanes gain nothing over the scalar kernel
+static void RunKernel(const EvaluationKernels &kernel, const char *board, float &middlegame_score, float &endgame_score, short &game_phase) noexcept {
+	switch(kernel) {
+#if SIMD_KERNELS
+		case AVX2_KERNEL:	Avx2Kernel(board, middlegame_score, endgame_score, game_phase);		return;
+#endif
+		default:			ScalarKernel(board, middlegame_score, endgame_score, game_phase);	return;
+	}
+}
+
+
+
+// chess class implementation of the full board evaluation
+
+// getter method, returns the kernel full board evaluations and neural networks use, the fastest one the CPU can run,
+// it is picked on the first call and never changes, only the self-check runs the other kernels, by passing them explicitly
+EvaluationKernels Chess::GetEvaluationKernel() noexcept {
+	static const EvaluationKernels kernel = BestKernel();
+	return kernel;
+}
+
+// computes the middlegame score, the endgame score and the game phase from scratch, the incrementally updated values must always be equal to these
+void Chess::ComputeEvaluation(float &full_middlegame_score, float &full_endgame_score, short &full_game_phase) const noexcept {
+	RunKernel(GetEvaluationKernel(), *board, full_middlegame_score, full_endgame_score, full_game_phase);
+}
+
+// returns the position reduced to what "EvaluateBoards" needs
+PackedBoard Chess::GetPackedBoard() const noexcept {
+	PackedBoard packed;
+	std::copy(&pieces[0][0], &pieces[0][0] + 2*6, &packed.pieces[0][0]);
+	packed.pawn_key = pawn_key;
+	packed.whites_turn = whites_turn;
+	return packed;
+}
+
+// evaluates all given boards in one call and writes their scores to "scores" in the same order, each score is from the point of view
+// of the player whose turn it is on that board and equal to what "EvaluateBoard" returns for the position without a neural network,
+// the material and position scores are computed from scratch by the evaluation kernel from a board laid out from the bitboards
+void Chess::EvaluateBoards(const std::vector<PackedBoard> &boards, std::vector<float> &scores, PawnHashTable *pawn_table) noexcept {
+	EvaluateBoards(boards, scores, GetEvaluationKernel(), pawn_table);
+}
+
+// function overload, the material and position scores are computed by the given kernel, which the CPU must be able to run
+void Chess::EvaluateBoards(const std::vector<PackedBoard> &boards, std::vector<float> &scores, const EvaluationKernels &kernel, PawnHashTable *pawn_table) noexcept {
+	scores.resize(boards.size());
+	char board[BOARD_SIZE*BOARD_SIZE];
+	for(size_t i=0;i<boards.size();++i) {
+		std::fill(board, board + BOARD_SIZE*BOARD_SIZE, static_cast<char>(EMPTY));
+		for(short white=0;white<2;++white)
+			for(short type=KING;type<=PAWN;++type)
+				for(Bitboard b = boards[i].pieces[white][type]; b;)
+					board[PopLeastSignificantSquare(b)] = white ? type + 1 : type - 6;		// the inverse of "PieceType"
+		float full_middlegame_score, full_endgame_score;
+		short full_game_phase;
+		RunKernel(kernel, board, full_middlegame_score, full_endgame_score, full_game_phase);
+		scores[i] = BlendEvaluation(boards[i].pieces, boards[i].pawn_key, boards[i].whites_turn, full_middlegame_score, full_endgame_score, full_game_phase, pawn_table);
+	}
+}
+
+// plays the given number of random games and checks in every position that each kernel the CPU can run gives exactly the incrementally
+// updated scores and that "EvaluateBoards" gives exactly what "EvaluateBoard" does without a network, if a neural network is given it also checks that
+// the incrementally updated accumulator is equal to one recomputed by the scalar kernel after every move and every undone move and that each kernel
+// gives the same network output, prints the result and returns true if every check passed
+bool Chess::EvaluationSelfCheck(const unsigned long &games, const std::shared_ptr<const NeuralNetwork> &network) noexcept {
+	static const unsigned short MAX_GAME_PLIES = 300;			// long enough for promotions to push the game phase above its maximum
+	static const char *KERNEL_NAMES[] = {"scalar", "SSE4.1", "AVX2"};		// [EvaluationKernels]
+	const EvaluationKernels &kernel_in_use = GetEvaluationKernel();
+	unsigned long long positions_checked = 0, mismatches = 0;
+	std::vector<PackedBoard> batch;
+	std::vector<float> expected_scores, scores;
+	for(unsigned long game=0;game<games;++game) {
+		Chess c("White", 1, "Black", 1);
+		c.SeedRandom(game + 1);
+		c.UseNetwork(network);
+		batch.clear();
+		expected_scores.clear();
+		MoveList all_moves;
+		Accumulator full_accumulator;
+		for(unsigned short ply=0;ply<MAX_GAME_PLIES;++ply) {
+			if(network) {
+				network->Refresh(full_accumulator, c.board, SCALAR_KERNEL);		// recomputed one value at a time to check the vector updates too
+				bool equal = true;
+				for(short perspective=0;perspective<2;++perspective)
+					equal &= std::equal(c.accumulator.values[perspective], c.accumulator.values[perspective] + network->GetHiddenSize(), full_accumulator.values[perspective]);
+				if(!equal && !mismatches++)
+					std::cout << "The accumulator is wrong in " << c.GetFEN() << std::endl;
+				for(short kernel=SSE4_KERNEL;kernel<=AVX2_KERNEL;++kernel)
+					if(KernelSupported(static_cast<EvaluationKernels>(kernel)) && network->Evaluate(c.accumulator, c.whites_turn, static_cast<EvaluationKernels>(kernel))
+					!= network->Evaluate(c.accumulator, c.whites_turn, SCALAR_KERNEL) && !mismatches++)
+						std::cout << "The " << KERNEL_NAMES[kernel] << " network output is wrong in " << c.GetFEN() << std::endl;
+			}
+			for(short kernel=SCALAR_KERNEL;kernel<=AVX2_KERNEL;++kernel) {
+				if(!KernelSupported(static_cast<EvaluationKernels>(kernel)))
+					continue;
+				float full_middlegame_score, full_endgame_score;
+				short full_game_phase;
+				RunKernel(static_cast<EvaluationKernels>(kernel), *c.board, full_middlegame_score, full_endgame_score, full_game_phase);
+				if(std::memcmp(&full_middlegame_score, &c.middlegame_score, sizeof(float)) || std::memcmp(&full_endgame_score, &c.endgame_score, sizeof(float))
+				|| full_game_phase != c.game_phase) {
+					if(!mismatches++)
+						std::cout << "The " << KERNEL_NAMES[kernel] << " kernel is wrong in " << c.GetFEN() << std::endl;
+				}
+			}
+			if(ply % 4 == 0) {
+				batch.push_back(c.GetPackedBoard());
+				expected_scores.push_back(BlendEvaluation(c.pieces, c.pawn_key, c.whites_turn, c.middlegame_score, c.endgame_score, c.game_phase, nullptr));
+			}
+			++positions_checked;
+			c.AllMoves(all_moves);
+			if(all_moves.Empty() || c.halfmove_clock >= 100)
+				break;
+			if(network) {				// a move played and undone must leave the accumulator as it was
+				const Accumulator saved = c.accumulator;
+				const Move &move = all_moves[c.GetRandomNumber<unsigned short>(0, all_moves.Size()-1)];
+				c.MovePiece(move);
+				c.MovePieceBack(move);
+				bool equal = true;
+				for(short perspective=0;perspective<2;++perspective)
+					equal &= std::equal(c.accumulator.values[perspective], c.accumulator.values[perspective] + network->GetHiddenSize(), saved.values[perspective]);
+				if(!equal && !mismatches++)
+					std::cout << "The accumulator is wrong after undoing " << move.ToString() << " in " << c.GetFEN() << std::endl;
+			}
+			c.MovePiece(all_moves[c.GetRandomNumber<unsigned short>(0, all_moves.Size()-1)]);
+		}
+		for(short kernel=SCALAR_KERNEL;kernel<=AVX2_KERNEL;++kernel) {
+			if(!KernelSupported(static_cast<EvaluationKernels>(kernel)))
+				continue;
+			EvaluateBoards(batch, scores, static_cast<EvaluationKernels>(kernel));
+			for(size_t i=0;i<batch.size();++i)
+				if(std::memcmp(&expected_scores[i], &scores[i], sizeof(float)) && !mismatches++)
+					std::cout << "The " << KERNEL_NAMES[kernel] << " batch evaluation is wrong in board " << i << " of game " << game + 1 << std::endl;
+		}
+	}
+	std::cout << "Evaluation kernels:";
+	for(short kernel=SCALAR_KERNEL;kernel<=AVX2_KERNEL;++kernel)
+		if(KernelSupported(static_cast<EvaluationKernels>(kernel)))
+			std::cout << " " << KERNEL_NAMES[kernel] << (kernel == kernel_in_use ? " (in use)" : "");
+	if(network)
+		std::cout << ", neural network with " << network->GetHiddenSize() << " hidden neurons";
+	std::cout << std::endl << positions_checked << " positions of " << games << " random games checked, " << mismatches << " mismatches" << std::endl;
+	std::cout << (mismatches ? "FAIL" : "PASS") << std::endl;
+	return !mismatches;
+}
@@ -0,0 +1,74 @@
+#include "chess.h"
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// memory-mapped file class implementation
+
+// destructor of memory-mapped file class
+MappedFile::~MappedFile() noexcept {
+	Close();
+}
+
+// maps the whole file at the given path into memory, returns false if the file cannot be mapped or is empty
+bool MappedFile::Open(const std::string &path) noexcept {
+	Close();
+#ifdef _WIN32
+	const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if(file == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER file_size;
+	if(GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0) {
+		if(const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)) {
+			data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+			CloseHandle(mapping);		// the view keeps the mapping alive
+			size = file_size.QuadPart;
+		}
+	}
+	CloseHandle(file);
+#else
+	const int file = open(path.c_str(), O_RDONLY);
+	if(file < 0)
+		return false;
+	struct stat status;
+	if(!fstat(file, &status) && status.st_size > 0) {
+		void *mapping = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, file, 0);
+		if(mapping != MAP_FAILED) {
+			data = static_cast<const unsigned char*>(mapping);
+			size = status.st_size;
+		}
+	}
+	close(file);		// the mapping keeps the file open
+#endif
+	if(!data)
+		size = 0;
+	return data;
+}
+
+// unmaps the file
+void MappedFile::Close() noexcept {
+	if(!data)
+		return;
+#ifdef _WIN32
+	UnmapViewOfFile(data);
+#else
+	munmap(const_cast<unsigned char*>(data), size);
+#endif
+	data = nullptr;
+	size = 0;
+}
+
+// getter method, returns the contents of the mapped file, a null pointer if no file is mapped
+const unsigned char* MappedFile::GetData() const noexcept {
+	return data;
+}
+
+// getter method, returns the size of the mapped file in bytes
+size_t MappedFile::GetSize() const noexcept {
+	return size;
+}
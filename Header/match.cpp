@@ -0,0 +1,131 @@
+#include "chess.h"
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <thread>
+
+// sprt settings implementation
+
+// returns the log-likelihood ratio at or below which H0 is accepted
+double SprtSettings::LowerBound() const noexcept {
+	return std::log(beta / (1 - alpha));
+}
+
+// returns the log-likelihood ratio at or above which H1 is accepted
+double SprtSettings::UpperBound() const noexcept {
+	return std::log((1 - beta) / alpha);
+}
+
+
+
+// match score implementation
+
+// returns the number of games played
+unsigned long long MatchScore::Games() const noexcept {
+	return wins + draws + losses;
+}
+
+// returns the average points per game of the first player, a win is 1 point and a draw is half a point
+double MatchScore::Score() const noexcept {
+	return Games() ? (wins + draws / 2.0) / Games() : 0.5;
+}
+
+// returns the elo difference that the score corresponds to, positive if the first player is stronger
+double MatchScore::EloDifference() const noexcept {
+	const double score = std::min(std::max(Score(), 1e-6), 1 - 1e-6);
+	return -400 * std::log10(1 / score - 1);
+}
+
+// returns the half width of the 95% confidence interval of the elo difference
+double MatchScore::EloError() const noexcept {
+	if(!Games())
+		return 0;
+	const double &score = Score(), &games = Games();
+	const double &deviation = std::sqrt((wins * std::pow(1 - score, 2) + draws * std::pow(0.5 - score, 2) + losses * std::pow(score, 2)) / games / games);
+	const double high = std::min(score + 1.959964 * deviation, 1 - 1e-6), low = std::max(score - 1.959964 * deviation, 1e-6);
+	return (-400 * std::log10(1 / high - 1) + 400 * std::log10(1 / low - 1)) / 2;
+}
+
+// returns the chance that the first player is stronger, draws tell nothing about it
+double MatchScore::LikelihoodOfSuperiority() const noexcept {
+	return wins + losses ? 0.5 * (1 + std::erf((static_cast<double>(wins) - losses) / std::sqrt(2.0 * (wins + losses)))) : 0.5;
+}
+
+// returns the log-likelihood ratio of H1 (the first player is elo1 stronger) against H0 (it is elo0 stronger), with the score of a game
+// taken as normally distributed with the variance of the games played so far
+double MatchScore::LogLikelihoodRatio(const double &elo0, const double &elo1) const noexcept {
+	const double &score = Score(), &games = Games();
+	const double &variance = games ? (wins * std::pow(1 - score, 2) + draws * std::pow(0.5 - score, 2) + losses * std::pow(score, 2)) / games : 0;
+	if(variance <= 0)
+		return 0;			// every game had the same result so far, the variance is not known yet
+	const double &score0 = 1 / (1 + std::pow(10, -elo0 / 400)), &score1 = 1 / (1 + std::pow(10, -elo1 / 400));
+	return games * (score1 - score0) * (2 * score - score0 - score1) / (2 * variance);
+}
+
+
+
+// match runner class implementation
+
+// constructor of match runner class, the match is played from the start position if there are no openings
+MatchRunner::MatchRunner(const MatchPlayer &first, const MatchPlayer &second, const std::vector<std::string> &openings, const unsigned short &threads) noexcept
+: players{first, second}, openings(openings), threads(std::max<unsigned short>(threads, 1)) {
+	if(this->openings.empty())
+		this->openings.push_back("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+}
+
+// plays a game from the position set up on "c" until it ends by the rules, returns 1 if white wins, -1 if black wins and 0 for a draw
+short MatchRunner::PlayGame(Chess &c, Bot &white, const MatchPlayer &white_player, Bot &black, const MatchPlayer &black_player) noexcept {
+	while(true) {
+		MoveList all_moves;
+		c.AllMoves(all_moves);
+		if(all_moves.Empty())
+			return c.IsCheck(c.GetTurn()) ? (c.GetTurn() ? -1 : 1) : 0;		// checkmate or stalemate
+		if(c.GetHalfmoveClock() >= 100 || c.IsRepetition(3))
+			return 0;			// fifty-move rule or threefold repetition
+		const Move &move = c.GetTurn() ? white.GetIdealMove(c, white_player.limits) : black.GetIdealMove(c, black_player.limits);
+		c.PlayMove(move);
+	}
+}
+
+// plays the given number of games, or fewer if the SPRT accepts one of its hypotheses, and returns the results, "progress" is called
+// after every game by one thread at a time, game i is played from opening i/2 with the first player taking white in even numbered games,
+// every game starts with cleared transposition tables and a random number generator seeded with its number so it does not depend on
+// which thread played it, games that are running when the SPRT finishes are played to the end and counted
+MatchScore MatchRunner::Run(const unsigned long long &games, const SprtSettings &sprt, const std::function<void(const MatchScore&)> &progress) noexcept {
+	MatchScore score;
+	std::mutex score_mutex;
+	std::atomic<unsigned long long> next_game(0);
+	std::atomic<bool> finished(false);
+	std::vector<std::thread> workers;
+	for(unsigned short i=0;i<threads;++i)
+		workers.emplace_back([&]() {
+			Chess c("White", 1, "Black", 1);
+			Bot bots[2] = {Bot("First", 1), Bot("Second", 1)};
+			for(short player=0;player<2;++player) {
+				bots[player].GetTranspositionTable().Resize(players[player].hash_megabytes);
+				bots[player].SetThreads(players[player].threads);
+				bots[player].SetNetwork(players[player].network);
+			}
+			for(unsigned long long game;!finished && (game = next_game++) < games;) {
+				const bool &first_is_white = game % 2 == 0;
+				if(!c.LoadFEN(openings[game/2 % openings.size()]))
+					continue;
+				c.SeedRandom(game);
+				for(Bot &bot : bots)
+					bot.GetTranspositionTable().Clear();
+				const short &result = first_is_white ? PlayGame(c, bots[0], players[0], bots[1], players[1]) : -PlayGame(c, bots[1], players[1], bots[0], players[0]);
+				std::lock_guard<std::mutex> lock(score_mutex);
+				++(result > 0 ? score.wins : result < 0 ? score.losses : score.draws);
+				if(sprt.enabled) {
+					const double &llr = score.LogLikelihoodRatio(sprt.elo0, sprt.elo1);
+					if(llr <= sprt.LowerBound() || llr >= sprt.UpperBound())
+						finished = true;
+				}
+				if(progress)
+					progress(score);
+			}
+		});
+	for(auto &worker : workers)
+		worker.join();
+	return score;
+}
@@ -0,0 +1,18 @@
+#include "chess.h"
+
+// move class implementation
+
+// returns the piece the pawn is promoted to, only meaningful if the move is a promotion
+char Move::GetPromotionPiece(const bool &white) const noexcept {
+	const char PROMOTION_PIECES[4] = {W_KNIGHT, W_BISHOP, W_ROOK, W_QUEEN};
+	return (white ? 1 : -1) * PROMOTION_PIECES[GetFlags() & 3];
+}
+
+// returns the move in coordinate notation, e.g. "e2e4" or "e7e8q"
+std::string Move::ToString() const noexcept {
+	std::string move = {static_cast<char>(GetFrom()%BOARD_SIZE + 'a'), static_cast<char>('8' - GetFrom()/BOARD_SIZE),
+						static_cast<char>(GetTo()%BOARD_SIZE + 'a'), static_cast<char>('8' - GetTo()/BOARD_SIZE)};
+	if(IsPromotion())
+		move.push_back("nbrq"[GetFlags() & 3]);
+	return move;
+}
@@ -0,0 +1,27 @@
+#include "chess.h"
+#include <algorithm>
+
+// move list class implementation
+
+// swaps the highest scored move among the moves from index "i" to the end into index "i" and returns it, one step of a selection sort
+Move MoveList::PickBest(const unsigned short &i) noexcept {
+	unsigned short best = i;
+	for(unsigned short j=i+1;j<size;++j)
+		if(scores[j] > scores[best])
+			best = j;
+	std::swap(moves[i], moves[best]);
+	std::swap(scores[i], scores[best]);
+	return moves[i];
+}
+
+// sorts all moves from the highest score to the lowest score
+void MoveList::Sort() noexcept {
+	for(unsigned short i=1;i<size;++i) {		// insertion sort, move lists are short and often nearly sorted
+		const Move move = moves[i];
+		const int score = scores[i];
+		unsigned short j = i;
+		for(;j>0 && scores[j-1] < score;--j)
+			moves[j] = moves[j-1], scores[j] = scores[j-1];
+		moves[j] = move, scores[j] = score;
+	}
+}
@@ -0,0 +1,188 @@
+#include "chess.h"
+#include <algorithm>
+#if SIMD_KERNELS
+#include <immintrin.h>
+#endif
+
+// neural network class implementation
+
+static const unsigned short FEATURE_COUNT = 2*6*BOARD_SIZE*BOARD_SIZE;		// (own or enemy, PieceTypes, square)
+static const int ACTIVATION_MAX = 255;				// the hidden values are clipped to [0, ACTIVATION_MAX]
+static const int OUTPUT_WEIGHT_SCALE = 64;			// the output weights are stored multiplied by this
+
+// returns the signed little-endian number of the given size in bytes
+static int64_t ReadLittleEndian(const unsigned char *bytes, const unsigned short &size) noexcept {
+	uint64_t value = 0;
+	for(short i=size-1;i>=0;--i)
+		value = (value << 8) | bytes[i];
+	const uint64_t &sign_bit = uint64_t(1) << (8*size - 1);
+	return static_cast<int64_t>(value ^ sign_bit) - static_cast<int64_t>(sign_bit);
+}
+
+// adds the given weight column to the hidden values if "add" is true and subtracts it otherwise, one value at a time, the sums wrap around
+// like the vector instructions' do
+static void ScalarUpdate(int16_t *values, const int16_t *weights, const unsigned short &hidden_size, const bool &add) noexcept {
+	for(unsigned short i=0;i<hidden_size;++i)
+		values[i] = static_cast<int16_t>(add ? values[i] + weights[i] : values[i] - weights[i]);
+}
+
+// returns the weighted sum of the clipped hidden values of both perspectives, computed one value at a time
+static int ScalarOutput(const int16_t *own, const int16_t *other, const int8_t *weights, const unsigned short &hidden_size) noexcept {
+	int sum = 0;
+	for(unsigned short i=0;i<hidden_size;++i)
+		sum += std::min(std::max<int>(own[i], 0), ACTIVATION_MAX) * weights[i] + std::min(std::max<int>(other[i], 0), ACTIVATION_MAX) * weights[hidden_size + i];
+	return sum;
+}
+
+#if SIMD_KERNELS
+// the SSE4.1 version of "ScalarUpdate", eight hidden values at a time
+__attribute__((target("sse4.1"))) static void Sse4Update(int16_t *values, const int16_t *weights, const unsigned short &hidden_size, const bool &add) noexcept {
+	for(unsigned short i=0;i<hidden_size;i+=8) {
+		const __m128i &value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)), &weight = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weights + i));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), add ? _mm_add_epi16(value, weight) : _mm_sub_epi16(value, weight));
+	}
+}
+
+// the AVX2 version of "ScalarUpdate", sixteen hidden values at a time
+__attribute__((target("avx2"))) static void Avx2Update(int16_t *values, const int16_t *weights, const unsigned short &hidden_size, const bool &add) noexcept {
+	for(unsigned short i=0;i<hidden_size;i+=16) {
+		const __m256i &value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)), &weight = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weights + i));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(values + i), add ? _mm256_add_epi16(value, weight) : _mm256_sub_epi16(value, weight));
+	}
+}
+
+// the SSE4.1 version of "ScalarOutput", eight hidden values at a time, every sum is an integer so the result is exactly the same
+__attribute__((target("sse4.1"))) static int Sse4Output(const int16_t *own, const int16_t *other, const int8_t *weights, const unsigned short &hidden_size) noexcept {
+	const __m128i &low = _mm_setzero_si128(), &high = _mm_set1_epi16(ACTIVATION_MAX);
+	__m128i sum = _mm_setzero_si128();
+	for(short half=0;half<2;++half) {
+		const int16_t *values = half ? other : own;
+		const int8_t *half_weights = weights + half * hidden_size;
+		for(unsigned short i=0;i<hidden_size;i+=8) {
+			const __m128i &clipped = _mm_min_epi16(_mm_max_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i)), low), high);
+			const __m128i &widened = _mm_cvtepi8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(half_weights + i)));
+			sum = _mm_add_epi32(sum, _mm_madd_epi16(clipped, widened));
+		}
+	}
+	alignas(16) int lanes[4];
+	_mm_store_si128(reinterpret_cast<__m128i*>(lanes), sum);
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+// the AVX2 version of "ScalarOutput", sixteen hidden values at a time
+__attribute__((target("avx2"))) static int Avx2Output(const int16_t *own, const int16_t *other, const int8_t *weights, const unsigned short &hidden_size) noexcept {
+	const __m256i &low = _mm256_setzero_si256(), &high = _mm256_set1_epi16(ACTIVATION_MAX);
+	__m256i sum = _mm256_setzero_si256();
+	for(short half=0;half<2;++half) {
+		const int16_t *values = half ? other : own;
+		const int8_t *half_weights = weights + half * hidden_size;
+		for(unsigned short i=0;i<hidden_size;i+=16) {
+			const __m256i &clipped = _mm256_min_epi16(_mm256_max_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)), low), high);
+			const __m256i &widened = _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(half_weights + i)));
+			sum = _mm256_add_epi32(sum, _mm256_madd_epi16(clipped, widened));
+		}
+	}
+	alignas(32) int lanes[8];
+	_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), sum);
+	return lanes[0] + lanes[1] + lanes[2] + lanes[3] + lanes[4] + lanes[5] + lanes[6] + lanes[7];
+}
+#endif
+
+// adds the given weight column to the hidden values or subtracts it from them with the given kernel
+static void Update(const EvaluationKernels &kernel, int16_t *values, const int16_t *weights, const unsigned short &hidden_size, const bool &add) noexcept {
+	switch(kernel) {
+#if SIMD_KERNELS
+		case AVX2_KERNEL:	Avx2Update(values, weights, hidden_size, add);		return;
+		case SSE4_KERNEL:	Sse4Update(values, weights, hidden_size, add);		return;
+#endif
+		default:			ScalarUpdate(values, weights, hidden_size, add);	return;
+	}
+}
+
+// loads the network from the file at the given path, returns false and keeps the network empty if the file cannot be read or is not a valid network
+bool NeuralNetwork::Load(const std::string &path) noexcept {
+	static const size_t HEADER_SIZE = 12;
+	hidden_size = 0;
+	MappedFile file;
+	if(!file.Open(path) || file.GetSize() < HEADER_SIZE)
+		return false;
+	const unsigned char *data = file.GetData();
+	const int64_t &version = ReadLittleEndian(data + 4, 4), &size = ReadLittleEndian(data + 8, 4);
+	if(std::string(reinterpret_cast<const char*>(data), 4) != "CBNN" || version != 1 || size <= 0 || size > NNUE_MAX_HIDDEN || size % 16)
+		return false;
+	if(file.GetSize() != HEADER_SIZE + 2*size + 2*FEATURE_COUNT*size + 2*size + 4)
+		return false;
+	hidden_biases.resize(size);
+	hidden_weights.resize(FEATURE_COUNT * size);
+	output_weights.resize(2 * size);
+	data += HEADER_SIZE;
+	for(auto &bias : hidden_biases)
+		bias = ReadLittleEndian(data, 2), data += 2;
+	for(auto &weight : hidden_weights)
+		weight = ReadLittleEndian(data, 2), data += 2;
+	for(auto &weight : output_weights)
+		weight = ReadLittleEndian(data, 1), data += 1;
+	output_bias = ReadLittleEndian(data, 4);
+	hidden_size = size;
+	return true;
+}
+
+// getter method, returns the number of hidden neurons of each perspective, zero if no network is loaded
+unsigned short NeuralNetwork::GetHiddenSize() const noexcept {
+	return hidden_size;
+}
+
+// returns the input of the given piece on the given square seen from the given team's perspective, the squares count from a1
+// of the perspective's own side, so the board is seen upside down from team black's perspective
+unsigned short NeuralNetwork::FeatureIndex(const bool &perspective, const char &piece, const short &square) noexcept {
+	const bool &own = (piece > 0) == perspective;
+	const short &relative_square = perspective ? square ^ 56 : square;		// the board's squares count from a8
+	return ((!own) * 6 + Chess::PieceType(piece)) * BOARD_SIZE*BOARD_SIZE + relative_square;
+}
+
+// computes the accumulator of the given board from scratch
+void NeuralNetwork::Refresh(Accumulator &accumulator, const char board[BOARD_SIZE][BOARD_SIZE]) const noexcept {
+	Refresh(accumulator, board, Chess::GetEvaluationKernel());
+}
+
+// function overload, the weight columns are added with the given kernel, which the CPU must be able to run
+void NeuralNetwork::Refresh(Accumulator &accumulator, const char board[BOARD_SIZE][BOARD_SIZE], const EvaluationKernels &kernel) const noexcept {
+	for(short perspective=0;perspective<2;++perspective)
+		std::copy(hidden_biases.begin(), hidden_biases.end(), accumulator.values[perspective]);
+	for(short square=0;square<BOARD_SIZE*BOARD_SIZE;++square)
+		if(board[square/BOARD_SIZE][square%BOARD_SIZE] != EMPTY)
+			for(short perspective=0;perspective<2;++perspective)
+				Update(kernel, accumulator.values[perspective], &hidden_weights[FeatureIndex(perspective, board[square/BOARD_SIZE][square%BOARD_SIZE], square) * hidden_size], hidden_size, true);
+}
+
+// updates the accumulator for the given piece put on the given square, one weight column is added to each perspective
+void NeuralNetwork::AddPiece(Accumulator &accumulator, const char &piece, const short &square) const noexcept {
+	for(short perspective=0;perspective<2;++perspective)
+		Update(Chess::GetEvaluationKernel(), accumulator.values[perspective], &hidden_weights[FeatureIndex(perspective, piece, square) * hidden_size], hidden_size, true);
+}
+
+// updates the accumulator for the given piece taken off the given square, one weight column is subtracted from each perspective
+void NeuralNetwork::RemovePiece(Accumulator &accumulator, const char &piece, const short &square) const noexcept {
+	for(short perspective=0;perspective<2;++perspective)
+		Update(Chess::GetEvaluationKernel(), accumulator.values[perspective], &hidden_weights[FeatureIndex(perspective, piece, square) * hidden_size], hidden_size, false);
+}
+
+// returns the score of the position whose accumulator is given in centipawns, from the point of view of the given team, which is taken as
+// the side to move, the output layer runs on the kernel of the full board evaluation, see "Chess::GetEvaluationKernel"
+int NeuralNetwork::Evaluate(const Accumulator &accumulator, const bool &perspective) const noexcept {
+	return Evaluate(accumulator, perspective, Chess::GetEvaluationKernel());
+}
+
+// function overload, the output layer runs on the given kernel, which the CPU must be able to run
+int NeuralNetwork::Evaluate(const Accumulator &accumulator, const bool &perspective, const EvaluationKernels &kernel) const noexcept {
+	const int16_t *own = accumulator.values[perspective], *other = accumulator.values[!perspective];
+	int sum;
+	switch(kernel) {
+#if SIMD_KERNELS
+		case AVX2_KERNEL:	sum = Avx2Output(own, other, output_weights.data(), hidden_size);		break;
+		case SSE4_KERNEL:	sum = Sse4Output(own, other, output_weights.data(), hidden_size);		break;
+#endif
+		default:			sum = ScalarOutput(own, other, output_weights.data(), hidden_size);	break;
+	}
+	return static_cast<int>((static_cast<int64_t>(sum) + output_bias) * NNUE_SCALE / (ACTIVATION_MAX * OUTPUT_WEIGHT_SCALE));
+}
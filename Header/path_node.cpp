@@ -1,63 +1,265 @@
 #include "chess.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
 
-// path node class implementation
+// search info implementation
 
-// creates a subtree which contains all possible moves the player can make
-void PathNode::CreateSubtree(Chess &c) noexcept {
-	auto all_moves = c.AllMoves();					// add all possible moves to the Node's map
-	for(auto &move : all_moves) {
-		Chess::ChangeToRealCoordinates(move[0], move[1], move[2], move[3]);
-		child_node_list.emplace(move, PathNode());
+// returns the number of seconds passed since the search started
+double SearchInfo::ElapsedTime() const noexcept {
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// counts a visited node and decides whether the search has to stop, the clock is only read every 1024 nodes,
+// the main thread is not stopped before it has searched one root move so there is always a move to return
+void SearchInfo::CountNode() noexcept {
+	const unsigned long long &count = nodes.load(std::memory_order_relaxed) + 1;
+	nodes.store(count, std::memory_order_relaxed);		// no other thread writes it, so it needs no atomic increment
+	if(stopped || (!thread_index && !has_root_move))
+		return;
+	if(stop && stop->load(std::memory_order_relaxed))
+		stopped = true;
+	else if(!limits.infinite && ((limits.max_nodes && count >= limits.max_nodes) || (limits.max_time > 0 && !(count & 1023) && ElapsedTime() >= limits.max_time)))
+		stopped = true;
+}
+
+// returns the static evaluation of the position for the player whose turn it is, looked up in the evaluation cache first if there is one
+float SearchInfo::Evaluate(const Chess &c) noexcept {
+	float score;
+	if(eval_cache && eval_cache->Probe(c.GetKey(), score)) {
+		++eval_cache_hits;
+#if CHECK_EVALUATION
+		assert(score == c.EvaluateBoard(c.GetTurn(), pawn_table));
+#endif
+		return score;
+	}
+	score = c.EvaluateBoard(c.GetTurn(), pawn_table);
+	if(eval_cache) {
+		++eval_cache_misses;
+		eval_cache->Store(c.GetKey(), score);
 	}
+	return score;
 }
 
-// returns the maximum score for the minimizing player and the minimum score for the maximizing player in each recursion
-float PathNode::AlphaBeta(Chess &c, unsigned short &depth, float alpha, float beta, const bool &maximizing_player, const bool &initial_turn) noexcept {
-	if(!depth)
-		return c.EvaluateBoard(initial_turn);
-	CreateSubtree(c);
-	float points = maximizing_player ? -9999 : 9999;
-	for(auto &node : child_node_list) {						// 1-0: from, 3-2: to
-		if(c.GetPiece(node.first[2], node.first[3]) == W_KING - 7*c.GetTurn()) {
-			child_node_list.clear();
-			return maximizing_player ? 9999 : -9999;		// if my target piece is king, then it is the most rewarding move
+// remembers the given quiet move that caused a beta cutoff as a killer move of the ply and rewards it in the history table,
+// the history table is halved when it grows too large so older cutoffs count less than recent ones
+void SearchInfo::UpdateQuietCutoff(const Move &move, const bool &white, const unsigned short &ply, const unsigned short &depth) noexcept {
+	if(killers[ply][0] != move)
+		killers[ply][1] = killers[ply][0], killers[ply][0] = move;
+	if((history[white][move.GetFrom()][move.GetTo()] += depth * depth) >= 1 << 20)
+		for(auto &from_history : history[white])
+			for(int &score : from_history)
+				score /= 2;
+}
+
+
+
+// path node class implementation, the nodes form the search stack: the node of a ply searches its moves with the node right after it,
+// so a search only touches as many nodes as it goes deep and reuses them in every iteration and every search
+
+// returns the ordering score of the given capture or promotion, the most valuable victim with the least valuable attacker first (MVV-LVA),
+// a promotion counts as capturing the promoted piece
+static int CaptureOrderScore(const Chess &c, const Move &move) noexcept {
+	static const int PIECE_ORDER_VALUES[6] = {100, 9, 3, 3, 5, 1};		// [PieceTypes]
+	const short &from = move.GetFrom(), &to = move.GetTo();
+	const int &victim = move.IsEnPassant() ? PIECE_ORDER_VALUES[PAWN] : move.IsCapture() ? PIECE_ORDER_VALUES[Chess::PieceType(c.GetPiece(to%BOARD_SIZE, to/BOARD_SIZE))] : 0;
+	const int &promotion = move.IsPromotion() ? PIECE_ORDER_VALUES[Chess::PieceType(move.GetPromotionPiece(true))] : 0;
+	return 16*(victim + promotion) - PIECE_ORDER_VALUES[Chess::PieceType(c.GetPiece(from%BOARD_SIZE, from/BOARD_SIZE))];
+}
+
+// fills the node's move list with all possible moves the player can make, ordered from the most to the least promising move: the move from the
+// transposition table, captures and promotions with the most valuable victim and the least valuable attacker first (MVV-LVA), the killer moves
+// of the ply, then the rest of the quiet moves by their history score
+void PathNode::CreateMoveList(Chess &c, const SearchInfo &info, const unsigned short &ply, const Move &tt_move) noexcept {
+	static const int TT_MOVE_SCORE = 1 << 30, CAPTURE_SCORE = 1 << 25, KILLER_SCORE = 1 << 24;		// history scores stay below 1 << 20
+	c.AllMoves(moves);
+	for(unsigned short i=0;i<moves.Size();++i) {
+		const Move &move = moves[i];
+		if(move == tt_move)
+			moves.SetScore(i, TT_MOVE_SCORE);
+		else if(move.IsCapture() || move.IsPromotion())
+			moves.SetScore(i, CAPTURE_SCORE + CaptureOrderScore(c, move));
+		else if(move == info.killers[ply][0] || move == info.killers[ply][1])
+			moves.SetScore(i, KILLER_SCORE + (move == info.killers[ply][0]));
+		else
+			moves.SetScore(i, info.history[c.GetTurn()][move.GetFrom()][move.GetTo()]);
+	}
+	moves.Sort();
+}
+
+// returns the score of the position for the player whose turn it is once the captures are played out, so that the static evaluation is never taken
+// in the middle of a capture sequence: the player can either stand pat (keep the static evaluation) or capture, and captures that could not raise
+// the score up to alpha even if the captured piece was won for free are skipped (delta pruning), in check every move is searched instead
+float PathNode::Quiescence(Chess &c, SearchInfo &info, const unsigned short &ply, float alpha, const float &beta) noexcept {
+	static const float DELTA_MARGIN = 20;			// two pawns, for the positional gains a capture can bring along
+	info.CountNode();
+	if(info.stopped)
+		return 0;
+	const float &stand_pat = info.Evaluate(c);
+	if(ply >= MAX_PLY-1)
+		return stand_pat;			// the search stack is full
+	const bool &in_check = c.IsCheck(c.GetTurn());
+	float points = -(MATE_SCORE - ply);		// checkmated if in check and no move is found
+	if(!in_check) {
+		if(stand_pat >= beta)
+			return stand_pat;
+		points = stand_pat;
+		alpha = std::max(alpha, stand_pat);
+	}
+	c.AllMoves(moves, !in_check);
+	for(unsigned short i=0;i<moves.Size();++i)
+		moves.SetScore(i, moves[i].IsCapture() || moves[i].IsPromotion() ? CaptureOrderScore(c, moves[i]) : -1000);
+	for(unsigned short i=0;i<moves.Size();++i) {
+		const Move &move = moves.PickBest(i);
+		if(!in_check && !move.IsPromotion()) {
+			const char &victim = move.IsEnPassant() ? static_cast<char>(W_PAWN) : c.GetPiece(move.GetTo()%BOARD_SIZE, move.GetTo()/BOARD_SIZE);
+			if(stand_pat + Chess::EvaluatePiece(victim) + DELTA_MARGIN <= alpha)
+				continue;
 		}
-		c.MovePiece(node.first[0], node.first[1], node.first[2], node.first[3], false, false);
-		points = maximizing_player ? std::max(points, node.second.AlphaBeta(c, --depth, alpha, beta, false, initial_turn))		// recursive alpha-beta algorithm
-		: std::min(points, node.second.AlphaBeta(c, --depth, alpha, beta, true, initial_turn));
-		maximizing_player ? alpha = std::max(alpha, points) : beta = std::min(beta, points);
-		++depth;
-		c.MovePieceBack(node.first[0], node.first[1], node.first[2], node.first[3]);
+		c.MovePiece(move);
+		const float &move_points = -this[1].Quiescence(c, info, ply+1, -beta, -alpha);
+		c.MovePieceBack(move);
+		if(info.stopped)
+			return 0;
+		if(move_points > points)
+			points = move_points;
+		alpha = std::max(alpha, points);
 		if(alpha >= beta)
 			break;
 	}
-	child_node_list.clear();
 	return points;
 }
 
-// the main function which returns the optimal move calculated by the alpha-beta algorithm
-std::string PathNode::AlphaBetaRoot(Chess &c, unsigned short &difficulty) noexcept {
-	CreateSubtree(c);
-	std::vector<std::string> ideal_moves;
-	float max_move_score = -9999;
-	for(auto &node : child_node_list) {
-		if(c.GetPiece(node.first[2], node.first[3]) == W_KING - 7*c.GetTurn()) {
-			child_node_list.clear();
-			return node.first;						// if my target piece is king, then this move is a game winner so return this move
+// returns the score of the position for the player whose turn it is, searched "depth" moves deep with the alpha-beta algorithm in its negamax form,
+// positions in the endgame tablebases are looked up, the transposition table is probed next for a stored result, then the moves are searched
+// in the order "CreateMoveList" puts them
+float PathNode::AlphaBeta(Chess &c, TranspositionTable &tt, SearchInfo &info, const unsigned short &depth, const unsigned short &ply, float alpha, float beta) noexcept {
+	if(!depth)
+		return Quiescence(c, info, ply, alpha, beta);
+	info.CountNode();
+	if(info.stopped)
+		return 0;
+	float tablebase_score;
+	if(info.tablebases && info.tablebases->Probe(c, tablebase_score))
+		return tablebase_score > 0 ? tablebase_score - ply : tablebase_score < 0 ? tablebase_score + ply : 0;		// the table counts the plies from this position
+	const float original_alpha = alpha;
+	Move tt_move;
+	float tt_score;
+	unsigned short tt_depth;
+	Bounds tt_bound;
+	if(tt.Probe(c.GetKey(), ply, tt_move, tt_score, tt_depth, tt_bound) && tt_depth >= depth)
+		if(tt_bound == EXACT_BOUND || (tt_bound == LOWER_BOUND && tt_score >= beta) || (tt_bound == UPPER_BOUND && tt_score <= alpha))
+			return tt_score;
+	CreateMoveList(c, info, ply, tt_move);
+	if(moves.Empty())
+		return c.IsCheck(c.GetTurn()) ? -(MATE_SCORE - ply) : 0;		// checkmate, the sooner the worse, or stalemate
+	float points = -MATE_SCORE;
+	Move best_move;
+	for(const auto &move : moves) {
+		c.MovePiece(move);
+		const float &move_points = c.IsRepetition(2) ? 0 : -this[1].AlphaBeta(c, tt, info, depth-1, ply+1, -beta, -alpha);	// recursive alpha-beta algorithm, a repeated position is a draw
+		c.MovePieceBack(move);
+		if(info.stopped)
+			break;
+		if(move_points > points)
+			points = move_points, best_move = move;
+		alpha = std::max(alpha, points);
+		if(alpha >= beta) {
+			if(!move.IsCapture() && !move.IsPromotion())
+				info.UpdateQuietCutoff(move, c.GetTurn(), ply, depth);
+			break;
 		}
-		c.MovePiece(node.first[0], node.first[1], node.first[2], node.first[3], false, false);
-		float move_score = node.second.AlphaBeta(c, difficulty, -10000, 10000, false, !c.GetTurn());
+	}
+	if(info.stopped)
+		return 0;			// the result of an abandoned search is incomplete, so it must not be stored
+	tt.Store(c.GetKey(), ply, best_move, points, depth, points <= original_alpha ? UPPER_BOUND : points >= beta ? LOWER_BOUND : EXACT_BOUND);
+	return points;
+}
+
+// searches every move of the root position "depth" moves deep, "best_move" is searched first and then replaced by the best move found,
+// moves that are as good as the best move are found with exact scores so one of them is picked randomly, returns false if the search is stopped,
+// unless it is the first iteration, which returns the best of the moves it has searched so the search always has a move
+bool PathNode::AlphaBetaRoot(Chess &c, TranspositionTable &tt, SearchInfo &info, const unsigned short &depth, Move &best_move, float &best_score) noexcept {
+	CreateMoveList(c, info, 0, best_move);			// the best move of the previous iteration is most likely the best again
+	MoveList ideal_moves;
+	float max_move_score = -10000;
+	for(const auto &move : moves) {
+		c.MovePiece(move);		// only moves that score at least as much as the best move so far need an exact score
+		const float &move_score = c.IsRepetition(2) ? 0 : -this[1].AlphaBeta(c, tt, info, depth-1, 1, -10000, -std::nextafter(max_move_score, -10000.0f));
+		c.MovePieceBack(move);
+		if(info.stopped)
+			break;
 		if(move_score > max_move_score) {
 			max_move_score = move_score;
-			ideal_moves.clear();
-			ideal_moves.emplace_back(node.first);	// add the most rewarding move to the list
+			ideal_moves.Clear();
+			ideal_moves.Add(move);		// add the most rewarding move to the list
 		}
 		else if(move_score == max_move_score)
-			ideal_moves.emplace_back(node.first);
-		c.MovePieceBack(node.first[0], node.first[1], node.first[2], node.first[3]);
+			ideal_moves.Add(move);
+		info.has_root_move = true;
+	}
+	if(ideal_moves.Empty() || (info.stopped && info.completed_depth))
+		return false;
+	best_move = ideal_moves[c.GetRandomNumber<unsigned short>(0, ideal_moves.Size()-1)];
+	best_score = max_move_score;
+	if(!info.stopped)
+		tt.Store(c.GetKey(), 0, best_move, max_move_score, depth, EXACT_BOUND);
+	return true;
+}
+
+// fills "pv" with the best move followed by the best replies stored in the transposition table, the stored moves are checked to be legal
+// and the line ends at a repeated position, since the table could hold moves of another position with the same key or loop forever
+void PathNode::PrincipalVariation(Chess &c, const TranspositionTable &tt, const Move &best_move, MoveList &pv) noexcept {
+	pv.Clear();
+	Move move = best_move;
+	while(!move.IsNull() && pv.Size() < MAX_SEARCH_DEPTH) {
+		MoveList all_moves;
+		c.AllMoves(all_moves);
+		if(std::find(all_moves.begin(), all_moves.end(), move) == all_moves.end())
+			break;
+		pv.Add(move);
+		c.MovePiece(move);
+		float score;
+		unsigned short depth;
+		Bounds bound;
+		if(c.IsRepetition(2) || !tt.Probe(c.GetKey(), pv.Size(), move, score, depth, bound))
+			break;
+	}
+	for(unsigned short i=pv.Size();i>0;--i)
+		c.MovePieceBack(pv[i-1]);
+}
+
+// the main function which returns the optimal move calculated by the alpha-beta algorithm, searches one move deeper in each iteration
+// until a limit of the search is reached and returns the best move of the last completed iteration
+Move PathNode::IterativeDeepening(Chess &c, TranspositionTable &tt, SearchInfo &info) noexcept {
+	const unsigned short max_depth = info.limits.infinite || !info.limits.max_depth ? MAX_SEARCH_DEPTH : std::min<unsigned short>(info.limits.max_depth, MAX_SEARCH_DEPTH);
+	Move best_move;
+	c.ReserveMoves(MAX_PLY);			// the search stack is never deeper than this, so no move of the search allocates
+	for(unsigned short depth=1+info.thread_index%2;depth<=max_depth;++depth) {
+		Move iteration_move = best_move;
+		float iteration_score;
+		if(!AlphaBetaRoot(c, tt, info, depth, iteration_move, iteration_score))
+			break;
+		best_move = iteration_move;
+		if(info.stopped)
+			break;				// the first iteration was stopped after some of its moves
+		info.completed_depth = depth;
+		if(info.report) {
+			SearchReport report;
+			report.depth = depth;
+			report.score = iteration_score;
+			report.nodes = info.nodes.load(std::memory_order_relaxed);
+			if(info.helpers)
+				for(const auto &helper : *info.helpers)
+					report.nodes += helper.nodes.load(std::memory_order_relaxed);
+			report.eval_cache_hits = info.eval_cache_hits;
+			report.eval_cache_misses = info.eval_cache_misses;
+			report.time = info.ElapsedTime();
+			PrincipalVariation(c, tt, best_move, report.principal_variation);
+			info.report(report);
+		}
+		if(!info.limits.infinite && info.limits.max_time > 0 && info.ElapsedTime() >= info.limits.max_time / 2)
+			break;			// the next iteration would most likely not complete in the remaining time
 	}
-	child_node_list.clear();						// delete the whole tree
-	auto move = ideal_moves.cbegin();
-	advance(move, GetRandomNumber<unsigned short>(0, ideal_moves.size()-1));
-	return *move;
+	return best_move;
 }
@@ -0,0 +1,46 @@
+#include "chess.h"
+
+// pawn hash table class implementation
+
+// constructor of pawn hash table class, the number of entries is rounded down to a power of two
+PawnHashTable::PawnHashTable(const size_t &entry_count) noexcept {
+	size_t count = 1;
+	while(2 * count <= entry_count)
+		count *= 2;
+	entries.resize(count);
+}
+
+// looks up the pawn structure scores of the given pawn key, returns true and fills the output parameters if they are found, false otherwise
+bool PawnHashTable::Probe(const uint64_t &key, float &middlegame_score, float &endgame_score) noexcept {
+	++probes;
+	const Entry &entry = entries[key & (entries.size()-1)];
+	if(entry.key != key)
+		return false;
+	++hits;
+	middlegame_score = entry.middlegame_score;
+	endgame_score = entry.endgame_score;
+	return true;
+}
+
+// stores the pawn structure scores of the given pawn key, replacing whatever was stored in its entry
+void PawnHashTable::Store(const uint64_t &key, const float &middlegame_score, const float &endgame_score) noexcept {
+	Entry &entry = entries[key & (entries.size()-1)];
+	entry.key = key;
+	entry.middlegame_score = middlegame_score;
+	entry.endgame_score = endgame_score;
+}
+
+// getter method, returns the number of lookups since the counters were reset
+unsigned long long PawnHashTable::GetProbes() const noexcept {
+	return probes;
+}
+
+// getter method, returns the number of lookups that found their entry since the counters were reset
+unsigned long long PawnHashTable::GetHits() const noexcept {
+	return hits;
+}
+
+// resets the lookup counters
+void PawnHashTable::ResetCounters() noexcept {
+	probes = hits = 0;
+}
@@ -0,0 +1,137 @@
+#include "chess.h"
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+// perft implementation, counts the leaf nodes of the move generation tree to test and measure "AllMoves", "MovePiece" and "MovePieceBack"
+
+// returns the number of positions reachable in exactly "depth" moves
+unsigned long long Chess::Perft(const unsigned short &depth) noexcept {
+	if(!depth)
+		return 1;
+	MoveList all_moves;
+	AllMoves(all_moves);
+	if(depth == 1)
+		return all_moves.Size();		// bulk counting, the leaves do not have to be played
+	unsigned long long nodes = 0;
+	for(const auto &move : all_moves) {
+		MovePiece(move);
+		nodes += Perft(depth-1);
+		MovePieceBack(move);
+	}
+	return nodes;
+}
+
+// returns the perft result by splitting the root moves across the given number of threads, each thread works on its own copy of the game
+// if "divide" is true then prints the number of nodes under each root move, and prints the total number of nodes and the speed in every case,
+// the speed is in leaves per second, which is higher than the rate of moves actually played since the last ply is only generated
+unsigned long long Chess::PerftRoot(const unsigned short &depth, const unsigned short &threads, const bool &divide) noexcept {
+	const auto &start = std::chrono::steady_clock::now();
+	MoveList all_moves;
+	AllMoves(all_moves);
+	std::vector<unsigned long long> move_nodes(all_moves.Size(), depth ? 1 : 0);
+	std::atomic<unsigned short> next_move(0);
+	auto Worker = [&](Chess c) {
+		for(unsigned short i; (i = next_move++) < all_moves.Size();) {
+			c.MovePiece(all_moves[i]);
+			move_nodes[i] = c.Perft(depth-1);
+			c.MovePieceBack(all_moves[i]);
+		}
+	};
+	if(depth > 1) {
+		std::vector<std::thread> workers;
+		for(unsigned short i=1;i<threads;++i)
+			workers.emplace_back(Worker, *this);
+		Worker(*this);
+		for(auto &worker : workers)
+			worker.join();
+	}
+	unsigned long long nodes = depth ? 0 : 1;
+	for(unsigned short i=0;i<all_moves.Size();++i) {
+		if(divide)
+			std::cout << all_moves[i].ToString() << ": " << move_nodes[i] << std::endl;
+		nodes += move_nodes[i];
+	}
+	const double &seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << (divide ? "\n" : "") << "Nodes: " << nodes << "\tTime: " << std::fixed << std::setprecision(3) << seconds << " s"
+	<< "\tLeaves/sec: " << static_cast<unsigned long long>(nodes / std::max(seconds, 1e-9)) << std::endl;
+	return nodes;
+}
+
+// runs perft on the standard reference positions and compares the results with the known node counts, returns true if all of them match
+bool Chess::PerftSuite(const unsigned short &threads) noexcept {
+	struct PerftPosition {
+		const char *name, *fen;
+		unsigned short depth;
+		unsigned long long nodes;
+	};
+	static const PerftPosition POSITIONS[] = {
+		{"initial position", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5, 4865609},
+		{"kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4, 4085603},
+		{"position 3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 6, 11030083},
+		{"position 4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 5, 15833292},
+		{"position 5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 4, 2103487},
+		{"position 6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 4, 3894594},
+		{"illegal en passant 1", "3k4/3p4/8/K1P4r/8/8/8/8 b - - 0 1", 6, 1134888},
+		{"illegal en passant 2", "8/8/4k3/8/2p5/8/B2P2K1/8 w - - 0 1", 6, 1015133},
+		{"en passant gives check", "8/8/1k6/2b5/2pP4/8/5K2/8 b - d3 0 1", 6, 1440467},
+		{"short castling gives check", "5k2/8/8/8/8/8/8/4K2R w K - 0 1", 6, 661072},
+		{"long castling gives check", "3k4/8/8/8/8/8/8/R3K3 w Q - 0 1", 6, 803711},
+		{"castling rights", "r3k2r/1b4bq/8/8/8/8/7B/R3K2R w KQkq - 0 1", 4, 1274206},
+		{"castling prevented", "r3k2r/8/3Q4/8/8/5q2/8/R3K2R b KQkq - 0 1", 4, 1720476},
+		{"promote out of check", "2K2r2/4P3/8/8/8/8/8/3k4 w - - 0 1", 6, 3821001},
+		{"discovered check", "8/8/1P2K3/8/2n5/1q6/8/5k2 b - - 0 1", 5, 1004658},
+		{"promote to give check", "4k3/1P6/8/8/8/8/K7/8 w - - 0 1", 6, 217342},
+		{"underpromote to check", "8/P1k5/K7/8/8/8/8/8 w - - 0 1", 6, 92683},
+		{"self stalemate", "K1k5/8/P7/8/8/8/8/8 w - - 0 1", 6, 2217},
+		{"stalemate and checkmate 1", "8/k1P5/8/1K6/8/8/8/8 w - - 0 1", 7, 567584},
+		{"stalemate and checkmate 2", "8/8/2k5/5q2/5n2/8/5K2/8 b - - 0 1", 4, 23527}};
+	bool all_passed = true;
+	for(const auto &position : POSITIONS) {
+		Chess c("White", 1, "Black", 1);
+		std::cout << position.name << " (depth " << position.depth << ")" << std::endl;
+		if(!c.LoadFEN(position.fen)) {
+			std::cout << "FAIL, invalid FEN" << std::endl << std::endl;
+			all_passed = false;
+			continue;
+		}
+		const unsigned long long &nodes = c.PerftRoot(position.depth, threads, false);
+		std::cout << (nodes == position.nodes ? "PASS" : "FAIL, expected " + std::to_string(position.nodes)) << std::endl << std::endl;
+		all_passed &= nodes == position.nodes;
+	}
+	std::cout << (all_passed ? "All perft tests passed." : "Some perft tests failed!") << std::endl;
+	return all_passed;
+}
+
+// runs perft on every position of the given EPD file and compares the results with the node counts in the "D1", "D2", ... operations of the
+// position, only the deepest count of each position is checked, returns true if all of them match
+bool Chess::PerftFile(const std::string &path, const unsigned short &threads) noexcept {
+	EpdReader reader(path);
+	if(!reader.IsOpen()) {
+		std::cout << "Cannot open " << path << std::endl;
+		return false;
+	}
+	bool all_passed = true;
+	EpdRecord record;
+	while(reader.Next(record)) {
+		unsigned short depth = 0;
+		std::string expected;
+		for(std::string nodes;!(nodes = record.GetOperation("D" + std::to_string(depth+1))).empty();++depth)
+			expected = nodes;
+		std::cout << "line " << record.line_number << " (depth " << depth << ")" << std::endl;
+		Chess c("White", 1, "Black", 1);
+		if(!depth || !c.LoadFEN(record.fen)) {
+			std::cout << (depth ? "FAIL, invalid FEN" : "FAIL, no node counts") << std::endl << std::endl;
+			all_passed = false;
+			continue;
+		}
+		const unsigned long long &nodes = c.PerftRoot(depth, threads, false);
+		std::cout << (std::to_string(nodes) == expected ? "PASS" : "FAIL, expected " + expected) << std::endl << std::endl;
+		all_passed &= std::to_string(nodes) == expected;
+	}
+	std::cout << (all_passed ? "All perft tests passed." : "Some perft tests failed!") << std::endl;
+	return all_passed;
+}
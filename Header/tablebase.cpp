@@ -0,0 +1,540 @@
+#include "chess.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+// endgame tablebases implementation
+
+static const char PIECE_LETTERS[] = "KQBNRP";			// [PieceTypes]
+static const short PIECE_VALUES[6] = {0, 9, 3, 3, 5, 1};	// [PieceTypes], decides which side of a table is white
+
+static short KING_SLOTS[2][BOARD_SIZE*BOARD_SIZE];		// [pawns][square], the place of the white king's square among the squares it can have in a table, -1 if it cannot
+static short KING_SQUARES[2][BOARD_SIZE*BOARD_SIZE];	// [pawns][slot], the reverse of "KING_SLOTS"
+static short KING_SLOT_COUNT[2];						// [pawns]
+
+// returns the given square moved by one of the symmetries of the board: bit 0 mirrors it left to right, bit 1 up to down
+// and bit 2 along the diagonal, tables with pawns only use the first symmetry
+static short TransformSquare(const short &square, const short &symmetry) noexcept {
+	short x = square % BOARD_SIZE, y = square / BOARD_SIZE;
+	if(symmetry & 1)
+		x = BOARD_SIZE-1 - x;
+	if(symmetry & 2)
+		y = BOARD_SIZE-1 - y;
+	if(symmetry & 4)
+		std::swap(x, y);
+	return y*BOARD_SIZE + x;
+}
+
+// fills the white king's squares, which are the squares that are the smallest among the squares the symmetries move them to,
+// 10 squares without pawns and the 32 squares of the left half of the board with pawns
+static bool InitTablebaseSquares() noexcept {
+	for(short pawns=0;pawns<2;++pawns) {
+		KING_SLOT_COUNT[pawns] = 0;
+		for(short square=0;square<BOARD_SIZE*BOARD_SIZE;++square) {
+			bool smallest = true;
+			for(short symmetry=0;symmetry<(pawns ? 2 : 8);++symmetry)
+				smallest &= TransformSquare(square, symmetry) >= square;
+			KING_SLOTS[pawns][square] = smallest ? KING_SLOT_COUNT[pawns] : -1;
+			if(smallest)
+				KING_SQUARES[pawns][KING_SLOT_COUNT[pawns]++] = square;
+		}
+	}
+	return true;
+}
+
+static const bool TABLEBASE_SQUARES_INITIALIZED = InitTablebaseSquares();
+
+// returns the squares the given piece located in the given square attacks
+static Bitboard PieceAttacks(const char &piece, const short &square, const Bitboard &occupied) noexcept {
+	switch(Chess::PieceType(piece)) {
+		case KING:		return KING_ATTACKS[square];
+		case QUEEN:		return RookAttacks(square, occupied) | BishopAttacks(square, occupied);
+		case BISHOP:	return BishopAttacks(square, occupied);
+		case KNIGHT:	return KNIGHT_ATTACKS[square];
+		case ROOK:		return RookAttacks(square, occupied);
+		default:		return PAWN_ATTACKS[piece > 0][square];
+	}
+}
+
+// returns the order of the given piece in a table: white king, black king, then the white and the black pieces by their types
+static short PieceOrder(const char &piece) noexcept {
+	return piece == W_KING ? 0 : piece == B_KING ? 1 : 2 + Chess::PieceType(piece) + 6*(piece < 0);
+}
+
+// runs "work" on the index ranges of the given size in parallel, the threads take the ranges in small chunks so they finish together
+static void ParallelFor(const size_t &size, const unsigned short &threads, const std::function<void(const size_t&, const size_t&)> &work) noexcept {
+	static const size_t CHUNK_SIZE = 1 << 14;
+	std::atomic<size_t> next(0);
+	auto Worker = [&]() {
+		for(size_t begin;(begin = next.fetch_add(CHUNK_SIZE)) < size;)
+			work(begin, std::min(begin + CHUNK_SIZE, size));
+	};
+	std::vector<std::thread> workers;
+	for(unsigned short i=1;i<threads;++i)
+		workers.emplace_back(Worker);
+	Worker();
+	for(auto &worker : workers)
+		worker.join();
+}
+
+// returns true if both teams have pawns in the given material, no such table is made: a double pawn push could then leave an en passant square,
+// which the positions of a table cannot have, and an en passant capture can change the result
+static bool PawnsOnBothSides(const unsigned &key) noexcept {
+	return ((key >> 2*(PAWN-1)) & 3) && ((key >> (10 + 2*(PAWN-1))) & 3);
+}
+
+// returns the key of the position's material, two bits count each white and black piece type other than the king
+unsigned Tablebases::MaterialKey(const Position &position) noexcept {
+	unsigned key = 0;
+	for(short i=0;i<position.count;++i)
+		if(Chess::PieceType(position.pieces[i]) != KING)
+			key += 1 << (10*(position.pieces[i] < 0) + 2*(Chess::PieceType(position.pieces[i]) - 1));
+	return key;
+}
+
+// returns the key of the given material with the colors swapped
+unsigned Tablebases::FlippedMaterialKey(const unsigned &key) noexcept {
+	return (key & 0x3FF) << 10 | key >> 10;
+}
+
+// returns the key the table of the given material is kept under, the one in which white has the more valuable pieces
+unsigned Tablebases::CanonicalMaterialKey(const unsigned &key) noexcept {
+	short white_value = 0, black_value = 0;
+	for(short type=QUEEN;type<=PAWN;++type) {
+		white_value += PIECE_VALUES[type] * ((key >> 2*(type-1)) & 3);
+		black_value += PIECE_VALUES[type] * ((key >> (10 + 2*(type-1))) & 3);
+	}
+	const unsigned &flipped = FlippedMaterialKey(key);
+	return white_value > black_value || (white_value == black_value && key >= flipped) ? key : flipped;
+}
+
+// reads a table name like "KRKN", the white pieces first and then the black ones, each side starting with its king,
+// returns false if the name is not the name of a table with at most "TABLEBASE_PIECES" pieces or the table would have pawns on both sides
+bool Tablebases::ParseName(const std::string &name, unsigned &key) noexcept {
+	std::string upper = name;
+	transform(upper.begin(), upper.end(), upper.begin(), [](const unsigned char &c){ return toupper(c); });
+	const size_t &black_king = upper.find('K', 1);
+	if(upper.size() > TABLEBASE_PIECES || upper[0] != 'K' || black_king == std::string::npos)
+		return false;
+	key = 0;
+	for(size_t i=1;i<upper.size();++i) {
+		const char *letter = strchr(PIECE_LETTERS + 1, upper[i]);
+		if(i == black_king)
+			continue;
+		if(!letter || !upper[i])
+			return false;
+		key += 1 << (10*(i > black_king) + 2*(letter - PIECE_LETTERS - 1));
+	}
+	return !PawnsOnBothSides(key);
+}
+
+// returns the name of the table of the given material
+std::string Tablebases::TableName(const unsigned &key) noexcept {
+	std::string name;
+	for(short black=0;black<2;++black) {
+		name += 'K';
+		for(short type=QUEEN;type<=PAWN;++type)
+			name += std::string((key >> (10*black + 2*(type-1))) & 3, PIECE_LETTERS[type]);
+	}
+	return name;
+}
+
+// fills the pieces and the size of the table of the given material, the positions are indexed by the side to move, the white king's slot
+// and the squares of the other pieces
+void Tablebases::SetUpTable(const unsigned &key, Table &table) noexcept {
+	table.name = TableName(key);
+	table.count = 2;
+	table.pieces[0] = W_KING;
+	table.pieces[1] = B_KING;
+	for(short black=0;black<2;++black)
+		for(short type=QUEEN;type<=PAWN;++type)
+			for(unsigned i=0;i<((key >> (10*black + 2*(type-1))) & 3);++i)
+				table.pieces[table.count++] = (black ? B_KING : W_KING) + type;
+	table.pawns = key & (3 << 2*(PAWN-1) | 3 << (10 + 2*(PAWN-1)));
+	table.size = 2 * KING_SLOT_COUNT[table.pawns];
+	for(short i=1;i<table.count;++i)
+		table.size *= BOARD_SIZE*BOARD_SIZE;
+}
+
+// returns the squares occupied by the pieces of the position
+Bitboard Tablebases::Occupancy(const Position &position) noexcept {
+	Bitboard occupied = 0;
+	for(short i=0;i<position.count;++i)
+		occupied |= Bitboard(1) << position.squares[i];
+	return occupied;
+}
+
+// returns true if one of the given team's pieces attacks the given square
+bool Tablebases::IsAttacked(const Position &position, const short &square, const bool &by_white) noexcept {
+	const Bitboard &occupied = Occupancy(position);
+	for(short i=0;i<position.count;++i)
+		if((position.pieces[i] > 0) == by_white && (PieceAttacks(position.pieces[i], position.squares[i], occupied) & (Bitboard(1) << square)))
+			return true;
+	return false;
+}
+
+// returns true if the position can happen in a game: no two pieces share a square, no pawn stands on the first or last rank
+// and the king of the side that just moved is not in check
+bool Tablebases::IsValid(const Position &position) noexcept {
+	short king_square = -1;
+	for(short i=0;i<position.count;++i) {
+		const short &y = position.squares[i] / BOARD_SIZE;
+		if(Chess::PieceType(position.pieces[i]) == PAWN && (y == 0 || y == BOARD_SIZE-1))
+			return false;
+		for(short j=0;j<i;++j)
+			if(position.squares[i] == position.squares[j])
+				return false;
+		if(position.pieces[i] == (position.white_to_move ? B_KING : W_KING))
+			king_square = position.squares[i];
+	}
+	return !IsAttacked(position, king_square, position.white_to_move);
+}
+
+// fills "children" with the positions after each legal move of the side to move, captures and promotions lead to positions of other tables,
+// en passant captures are not generated since no table has pawns on both sides
+void Tablebases::AllMoves(const Position &position, std::vector<Position> &children) noexcept {
+	children.clear();
+	const bool &white = position.white_to_move;
+	const Bitboard &occupied = Occupancy(position);
+	Bitboard own = 0;
+	short king = 0;
+	for(short i=0;i<position.count;++i)
+		if((position.pieces[i] > 0) == white) {
+			own |= Bitboard(1) << position.squares[i];
+			if(Chess::PieceType(position.pieces[i]) == KING)
+				king = i;
+		}
+	for(short i=0;i<position.count;++i) {
+		const char &piece = position.pieces[i];
+		if((piece > 0) != white)
+			continue;
+		const short &from = position.squares[i];
+		Bitboard targets;
+		if(Chess::PieceType(piece) == PAWN) {
+			const short &forward = white ? -BOARD_SIZE : BOARD_SIZE, &start_rank = white ? BOARD_SIZE-2 : 1;
+			targets = PAWN_ATTACKS[white][from] & occupied & ~own;
+			if(!(occupied & (Bitboard(1) << (from + forward)))) {
+				targets |= Bitboard(1) << (from + forward);
+				if(from / BOARD_SIZE == start_rank && !(occupied & (Bitboard(1) << (from + 2*forward))))
+					targets |= Bitboard(1) << (from + 2*forward);
+			}
+		}
+		else
+			targets = PieceAttacks(piece, from, occupied) & ~own;
+		while(targets) {
+			const short &to = PopLeastSignificantSquare(targets), &captured = std::find(position.squares, position.squares + position.count, to) - position.squares;
+			Position child;
+			child.white_to_move = !white;
+			for(short j=0;j<position.count;++j)
+				if(j != captured) {
+					child.pieces[child.count] = position.pieces[j];
+					child.squares[child.count++] = j == i ? to : position.squares[j];
+				}
+			const short &moved = i - (captured < i), &moved_king = king - (captured < king);		// the pieces after a captured piece move one place up
+			if(IsAttacked(child, child.squares[moved_king], !white))
+				continue;
+			if(Chess::PieceType(piece) == PAWN && (to / BOARD_SIZE == 0 || to / BOARD_SIZE == BOARD_SIZE-1))
+				for(short type=QUEEN;type<=ROOK;++type) {
+					child.pieces[moved] = (white ? W_KING : B_KING) + type;
+					children.push_back(child);
+				}
+			else
+				children.push_back(child);
+		}
+	}
+}
+
+// fills "parents" with the positions of the same table that lead to the given position with one legal move of the side that just moved,
+// pieces are moved back to the empty squares they could have come from, captures and promotions are not taken back
+void Tablebases::Predecessors(const Position &position, std::vector<Position> &parents) noexcept {
+	parents.clear();
+	const bool &white = !position.white_to_move;		// the side that made the last move
+	const Bitboard &occupied = Occupancy(position);
+	for(short i=0;i<position.count;++i) {
+		const char &piece = position.pieces[i];
+		if((piece > 0) != white)
+			continue;
+		const short &to = position.squares[i];
+		Bitboard origins;
+		if(Chess::PieceType(piece) == PAWN) {
+			const short &backward = white ? BOARD_SIZE : -BOARD_SIZE, &double_push_rank = white ? BOARD_SIZE/2 : BOARD_SIZE/2 - 1;
+			origins = 0;
+			if(!(occupied & (Bitboard(1) << (to + backward)))) {
+				const short &y = (to + backward) / BOARD_SIZE;
+				if(y != 0 && y != BOARD_SIZE-1)
+					origins |= Bitboard(1) << (to + backward);
+				if(to / BOARD_SIZE == double_push_rank && !(occupied & (Bitboard(1) << (to + 2*backward))))
+					origins |= Bitboard(1) << (to + 2*backward);
+			}
+		}
+		else
+			origins = PieceAttacks(piece, to, occupied) & ~occupied;
+		while(origins) {
+			Position parent = position;
+			parent.white_to_move = white;
+			parent.squares[i] = PopLeastSignificantSquare(origins);
+			if(IsValid(parent))
+				parents.push_back(parent);
+		}
+	}
+}
+
+// returns the index of the position in the table, every position is first moved by the symmetry that gives it the smallest index
+// so the positions that are the same up to a symmetry share one entry, the pieces must be in the order of the table's pieces
+size_t Tablebases::Index(const Table &table, const Position &position) noexcept {
+	size_t best = table.size;
+	for(short symmetry=0;symmetry<(table.pawns ? 2 : 8);++symmetry) {
+		short squares[TABLEBASE_PIECES] = {};
+		for(short i=0;i<position.count;++i)
+			squares[i] = TransformSquare(position.squares[i], symmetry);
+		const short &slot = KING_SLOTS[table.pawns][squares[0]];
+		if(slot < 0)
+			continue;
+		for(short i=3;i<position.count;++i)		// pieces of the same kind are put in the order of their squares
+			for(short j=i;j>2 && table.pieces[j] == table.pieces[j-1] && squares[j] < squares[j-1];--j)
+				std::swap(squares[j], squares[j-1]);
+		size_t index = (!position.white_to_move) * KING_SLOT_COUNT[table.pawns] + slot;
+		for(short i=1;i<position.count;++i)
+			index = index * (BOARD_SIZE*BOARD_SIZE) + squares[i];
+		best = std::min(best, index);
+	}
+	return best;
+}
+
+// fills the position of the given index of the table, returns false if the position is not valid or another index stands for it
+bool Tablebases::Decode(const Table &table, const size_t &index, Position &position) noexcept {
+	size_t rest = index;
+	position.count = table.count;
+	for(short i=table.count-1;i>0;--i) {
+		position.pieces[i] = table.pieces[i];
+		position.squares[i] = rest % (BOARD_SIZE*BOARD_SIZE);
+		rest /= BOARD_SIZE*BOARD_SIZE;
+	}
+	position.pieces[0] = table.pieces[0];
+	position.squares[0] = KING_SQUARES[table.pawns][rest % KING_SLOT_COUNT[table.pawns]];
+	position.white_to_move = rest < static_cast<size_t>(KING_SLOT_COUNT[table.pawns]);
+	return IsValid(position) && Index(table, position) == index;
+}
+
+// returns the table of the position's material, the colors of the position are swapped if the table has them the other way around
+// and its pieces are put in the order of the table's pieces, returns a null pointer if the table is not loaded
+const Tablebases::Table* Tablebases::FindTable(Position &position) const noexcept {
+	const unsigned &key = MaterialKey(position);
+	auto table = tables.find(key);
+	if(table == tables.end()) {
+		table = tables.find(FlippedMaterialKey(key));
+		if(table == tables.end())
+			return nullptr;
+		for(short i=0;i<position.count;++i) {
+			position.pieces[i] += position.pieces[i] > 0 ? B_KING - W_KING : W_KING - B_KING;
+			position.squares[i] ^= (BOARD_SIZE-1) * BOARD_SIZE;		// mirrored up to down
+		}
+		position.white_to_move = !position.white_to_move;
+	}
+	for(short i=1;i<position.count;++i)
+		for(short j=i;j>0 && PieceOrder(position.pieces[j]) < PieceOrder(position.pieces[j-1]);--j) {
+			std::swap(position.pieces[j], position.pieces[j-1]);
+			std::swap(position.squares[j], position.squares[j-1]);
+		}
+	return &table->second;
+}
+
+// looks the position up in its table, returns false if the table is not loaded or not made yet, two kings are always a draw
+bool Tablebases::ProbeValue(Position position, unsigned char &value) const noexcept {
+	if(position.count == 2) {
+		value = 0;
+		return true;
+	}
+	const Table *table = FindTable(position);
+	if(!table || !table->values)
+		return false;
+	value = table->values[Index(*table, position)];
+	return true;
+}
+
+// solves every position of the table by retrograde analysis: the mates and the positions decided by captures and promotions are found first,
+// then at each distance the positions lost at that distance make their predecessors won one ply later, and the positions won at that distance
+// make those predecessors lost whose every move leads to a win of the opponent, until no position is decided anymore, the rest are draws
+void Tablebases::GenerateTable(Table &table, const unsigned short &threads) const noexcept {
+	std::vector<std::atomic<unsigned char>> values(table.size);
+	std::atomic<unsigned char> max_value(0);
+	auto Decide = [&values, &max_value](const size_t &index, const unsigned char &value) {		// only undecided positions and longer wins can be changed
+		unsigned char current = values[index].load();
+		while((!current || (current > value && current % 2 == 0 && value % 2 == 0)) && !values[index].compare_exchange_weak(current, value));
+		for(unsigned char max = max_value.load();max < value && !max_value.compare_exchange_weak(max, value););
+	};
+	ParallelFor(table.size, threads, [&](const size_t &begin, const size_t &end) {
+		std::vector<Position> children;
+		for(size_t i=begin;i<end;++i) {
+			Position position;
+			if(!Decode(table, i, position))
+				continue;
+			AllMoves(position, children);
+			if(children.empty()) {
+				if(IsAttacked(position, position.squares[!position.white_to_move], !position.white_to_move))
+					Decide(i, 1);			// checkmate, lost in 0 plies
+				continue;
+			}
+			bool quiet_moves = false, all_lost = true;
+			unsigned char win = 0, loss = 0;
+			for(const auto &child : children) {
+				unsigned char value;
+				if(child.count == position.count && !memcmp(child.pieces, position.pieces, position.count))
+					quiet_moves = true;
+				else if(!ProbeValue(child, value) || !value)
+					all_lost = false;
+				else if(value % 2)			// the opponent is lost in "value - 1" plies, so this position is won in "value" plies
+					win = win ? std::min(win, value) : value;
+				else
+					loss = std::max(loss, value);
+			}
+			if(win)
+				Decide(i, win + 1);
+			else if(!quiet_moves && all_lost)
+				Decide(i, loss + 1);
+		}
+	});
+	for(unsigned char value=1;value<=max_value.load() && value<255;++value) {		// the positions decided "value - 1" plies from mate
+		ParallelFor(table.size, threads, [&](const size_t &begin, const size_t &end) {
+			std::vector<Position> parents, children;
+			for(size_t i=begin;i<end;++i) {
+				if(values[i].load(std::memory_order_relaxed) != value)
+					continue;
+				Position position;
+				Decode(table, i, position);
+				Predecessors(position, parents);
+				for(const auto &parent : parents) {
+					const size_t &parent_index = Index(table, parent);
+					if(value % 2) {			// lost, so the parent is won one ply later
+						Decide(parent_index, value + 1);
+						continue;
+					}
+					if(values[parent_index].load())		// won, so the parent is lost if all of its moves lead to decided wins of the opponent
+						continue;
+					AllMoves(parent, children);
+					unsigned char loss = 0;
+					for(const auto &child : children) {
+						unsigned char child_value;
+						if(child.count == parent.count && !memcmp(child.pieces, parent.pieces, parent.count)) {
+							child_value = values[Index(table, child)].load();
+							if(child_value > value)
+								child_value = 0;			// not decided for good yet
+						}
+						else if(!ProbeValue(child, child_value))
+							child_value = 0;
+						if(!child_value || child_value % 2) {
+							loss = 0;
+							break;
+						}
+						loss = std::max(loss, child_value);
+					}
+					if(loss)
+						Decide(parent_index, loss + 1);
+				}
+			}
+		});
+	}
+	table.generated.resize(table.size);
+	for(size_t i=0;i<table.size;++i)
+		table.generated[i] = values[i].load();
+	table.values = table.generated.data();
+}
+
+// makes the table of the given material available, along with every table its captures and promotions lead to, a table is read from its file
+// in the directory if there is one and made and saved there otherwise, returns false if a table cannot be saved
+bool Tablebases::AddTable(const unsigned &material_key, const std::string &directory, const unsigned short &threads, const std::function<void(const std::string&)> &progress) noexcept {
+	const unsigned &key = CanonicalMaterialKey(material_key);
+	if(!key || (tables.count(key) && tables[key].values))
+		return true;			// two kings need no table
+	bool saved = true;
+	for(short black=0;black<2;++black)
+		for(short type=QUEEN;type<=PAWN;++type) {
+			const short &shift = 10*black + 2*(type-1);
+			if(!((key >> shift) & 3))
+				continue;
+			saved &= AddTable(key - (1 << shift), directory, threads, progress);		// the piece is captured
+			if(type == PAWN)
+				for(short promotion=QUEEN;promotion<=ROOK;++promotion)
+					saved &= AddTable(key - (1 << shift) + (1 << (10*black + 2*(promotion-1))), directory, threads, progress);
+		}
+	Table &table = tables[key];
+	SetUpTable(key, table);
+	const std::string &path = (directory.empty() ? "" : directory + "/") + table.name + ".tb";
+	if(table.file.Open(path) && table.file.GetSize() == table.size) {
+		table.values = table.file.GetData();
+		max_pieces = std::max<unsigned short>(max_pieces, table.count);
+		return saved;
+	}
+	table.file.Close();
+	GenerateTable(table, threads);
+	max_pieces = std::max<unsigned short>(max_pieces, table.count);
+	std::ofstream file(path, std::ios::binary);
+	file.write(reinterpret_cast<const char*>(table.generated.data()), table.size);
+	saved &= file.good();
+	if(progress) {
+		unsigned char longest = 0;
+		for(const auto &value : table.generated)
+			if(value % 2 == 0)
+				longest = std::max(longest, value);
+		progress(table.name + ": " + std::to_string(table.size) + " positions, longest win " + std::to_string(longest ? longest - 1 : 0) + " plies" + (file.good() ? "" : ", cannot save " + path));
+	}
+	return saved;
+}
+
+// loads every table file of the given directory, returns the number of tables loaded
+unsigned short Tablebases::Load(const std::string &directory) noexcept {
+	unsigned short loaded = 0;
+	for(unsigned key=1;key<1<<20;++key) {
+		short count = 2;
+		for(short shift=0;shift<20;shift+=2)
+			count += (key >> shift) & 3;
+		if(count > TABLEBASE_PIECES || CanonicalMaterialKey(key) != key || PawnsOnBothSides(key) || (tables.count(key) && tables[key].values))
+			continue;
+		Table &table = tables[key];
+		SetUpTable(key, table);
+		if(table.file.Open((directory.empty() ? "" : directory + "/") + table.name + ".tb") && table.file.GetSize() == table.size) {
+			table.values = table.file.GetData();
+			max_pieces = std::max<unsigned short>(max_pieces, table.count);
+			++loaded;
+		}
+		else
+			tables.erase(key);
+	}
+	return loaded;
+}
+
+// makes the table with the given name (e.g. "KBNK") and the tables it depends on on the given number of threads and saves them in the directory,
+// tables already saved there are read instead, "progress" is called with a summary of each table made, returns false if the name is not valid
+// or a table cannot be saved
+bool Tablebases::Generate(const std::string &name, const std::string &directory, const unsigned short &threads, const std::function<void(const std::string&)> &progress) noexcept {
+	unsigned key;
+	return ParseName(name, key) && AddTable(key, directory, std::max<unsigned short>(threads, 1), progress);
+}
+
+// getter method, returns the most pieces a loaded table has, zero if no table is loaded
+unsigned short Tablebases::GetMaxPieces() const noexcept {
+	return max_pieces;
+}
+
+// looks the position of the game up, returns false if it has too many pieces, castling rights or an en passant square or its table is not loaded,
+// which is always so with pawns on both sides, otherwise "score" is set to the score of the position for the player whose turn it is: zero for
+// a draw and "TABLEBASE_WIN" minus the distance to mate in plies for a win, negated for a loss, so the search prefers quicker wins and slower losses
+bool Tablebases::Probe(const Chess &c, float &score) const noexcept {
+	if(!max_pieces || c.GetCastlingRights() || c.GetEnPassant() != -1)
+		return false;
+	Position position;
+	position.white_to_move = c.GetTurn();
+	for(short white=1;white>=0;--white)
+		for(short type=KING;type<=PAWN;++type)
+			for(Bitboard pieces = c.GetPieces(white, type);pieces;) {
+				if(position.count == max_pieces)
+					return false;
+				position.pieces[position.count] = (white ? W_KING : B_KING) + type;
+				position.squares[position.count++] = PopLeastSignificantSquare(pieces);
+			}
+	unsigned char value;
+	if(!ProbeValue(position, value))
+		return false;
+	score = !value ? 0 : value % 2 ? -(TABLEBASE_WIN - (value - 1)) : TABLEBASE_WIN - (value - 1);
+	return true;
+}
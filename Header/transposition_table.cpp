@@ -0,0 +1,169 @@
+#include "chess.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+// transposition table class implementation
+
+// returns the given score of a position at the given ply counted from the root of the search as counted from the position itself,
+// so a mate or tablebase score can be stored once and found at any ply
+static float ScoreFromRoot(const float &score, const unsigned short &ply) noexcept {
+	return score >= DISTANCE_SCORE ? score + ply : score <= -DISTANCE_SCORE ? score - ply : score;
+}
+
+// the reverse of "ScoreFromRoot", returns the given score counted from the position as counted from the root of the search
+static float ScoreToRoot(const float &score, const unsigned short &ply) noexcept {
+	return score >= DISTANCE_SCORE ? score - ply : score <= -DISTANCE_SCORE ? score + ply : score;
+}
+
+// returns the data word of an entry holding the given search result
+static uint64_t PackEntry(const Move &move, const float &score, const unsigned short &depth, const unsigned char &generation_and_bound) noexcept {
+	uint32_t score_bits;
+	std::memcpy(&score_bits, &score, sizeof(score_bits));
+	const uint64_t &move_bits = move.GetFrom() | (move.GetTo() << 6) | (move.GetFlags() << 12);
+	return score_bits | move_bits << 32 | uint64_t(std::min<unsigned short>(depth, 255)) << 48 | uint64_t(generation_and_bound) << 56;
+}
+
+// returns the best move of the given data word
+static Move EntryMove(const uint64_t &data) noexcept {
+	return Move((data >> 32) & 0x3F, (data >> 38) & 0x3F, static_cast<MoveFlags>((data >> 44) & 0xF));
+}
+
+// returns the score of the given data word
+static float EntryScore(const uint64_t &data) noexcept {
+	const uint32_t &score_bits = static_cast<uint32_t>(data);
+	float score;
+	std::memcpy(&score, &score_bits, sizeof(score));
+	return score;
+}
+
+// returns the depth of the given data word
+static unsigned short EntryDepth(const uint64_t &data) noexcept {
+	return (data >> 48) & 0xFF;
+}
+
+// returns the search that stored the given data word in the upper 6 bits and its bound plus one in the lower 2 bits, zero if the entry is empty
+static unsigned char EntryGenerationAndBound(const uint64_t &data) noexcept {
+	return static_cast<unsigned char>(data >> 56);
+}
+
+// constructor of transposition table class, allocates a table of the given size in megabytes
+TranspositionTable::TranspositionTable(const size_t &megabytes, const bool &huge_pages) noexcept {
+	Resize(megabytes, huge_pages);
+}
+
+// destructor of transposition table class
+TranspositionTable::~TranspositionTable() noexcept {
+	Free();
+}
+
+// releases the memory of the table
+void TranspositionTable::Free() noexcept {
+	if(!buckets)
+		return;
+#ifdef _WIN32
+	VirtualFree(buckets, 0, MEM_RELEASE);
+#else
+	free(buckets);
+#endif
+	buckets = nullptr;
+	bucket_count = 0;
+}
+
+// reallocates the table with the largest power of two number of buckets that fits into the given size in megabytes and clears it,
+// if "huge_pages" is true then the table is backed by huge (large) pages when the operating system allows it, returns false if the allocation failed
+bool TranspositionTable::Resize(const size_t &megabytes, const bool &huge_pages) noexcept {
+	Free();
+	size_t count = 1;
+	while(2 * count * sizeof(Bucket) <= std::max<size_t>(megabytes, 1) << 20)
+		count *= 2;
+	const size_t &size = count * sizeof(Bucket);
+#ifdef _WIN32
+	if(huge_pages && GetLargePageMinimum() && size % GetLargePageMinimum() == 0)		// needs the "lock pages in memory" privilege
+		buckets = static_cast<Bucket*>(VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE));
+	if(!buckets)
+		buckets = static_cast<Bucket*>(VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+#else
+	const size_t &alignment = huge_pages && size % (2 << 20) == 0 ? 2 << 20 : sizeof(Bucket);
+	if(posix_memalign(reinterpret_cast<void**>(&buckets), alignment, size))
+		buckets = nullptr;
+#ifdef MADV_HUGEPAGE
+	else if(huge_pages)
+		madvise(buckets, size, MADV_HUGEPAGE);
+#endif
+#endif
+	if(!buckets)
+		return false;
+	bucket_count = count;
+	Clear();
+	return true;
+}
+
+// removes every entry from the table
+void TranspositionTable::Clear() noexcept {
+	for(size_t i=0;i<bucket_count;++i)
+		new (buckets + i) Bucket();			// value-initialized, so every entry is empty
+	generation = 0;
+}
+
+// starts a new search, entries stored by earlier searches are kept but they are replaced before the entries of the new search
+void TranspositionTable::NewSearch() noexcept {
+	generation = (generation + 1) & 0x3F;
+}
+
+// looks up the given position found at the given ply of the search, returns true and fills the output parameters if the position is found
+// in the table, false otherwise, mate and tablebase scores are returned as counted from the root of the search, an entry another thread
+// is writing at the same time does not pass the xor check and counts as not found
+bool TranspositionTable::Probe(const uint64_t &key, const unsigned short &ply, Move &move, float &score, unsigned short &depth, Bounds &bound) const noexcept {
+	if(!buckets)
+		return false;
+	const Bucket &bucket = buckets[key & (bucket_count-1)];
+	for(const Entry &entry : bucket.entries) {
+		const uint64_t &data = entry.data.load(std::memory_order_relaxed), &check = entry.check.load(std::memory_order_relaxed);
+		if((check ^ data) == key && EntryGenerationAndBound(data)) {
+			move = EntryMove(data);
+			score = ScoreToRoot(EntryScore(data), ply);
+			depth = EntryDepth(data);
+			bound = static_cast<Bounds>((EntryGenerationAndBound(data) & 3) - 1);
+			return true;
+		}
+	}
+	return false;
+}
+
+// stores the result of a search of the given position, the entry of the same position is overwritten if it exists,
+// otherwise the least valuable entry of the bucket is replaced, which is the shallowest one with older searches' entries counting as shallower,
+// mate and tablebase scores are stored as counted from the position at the given ply instead of from the root of the search
+void TranspositionTable::Store(const uint64_t &key, const unsigned short &ply, const Move &move, const float &score, const unsigned short &depth, const Bounds &bound) noexcept {
+	if(!buckets)
+		return;
+	Bucket &bucket = buckets[key & (bucket_count-1)];
+	Entry *replace = bucket.entries;
+	uint64_t replace_data = replace->data.load(std::memory_order_relaxed);
+	bool same_position = false;
+	for(Entry &entry : bucket.entries) {
+		const uint64_t &data = entry.data.load(std::memory_order_relaxed);
+		if((entry.check.load(std::memory_order_relaxed) ^ data) == key && EntryGenerationAndBound(data)) {
+			replace = &entry, replace_data = data, same_position = true;
+			break;
+		}
+		if(EntryWorth(data) < EntryWorth(replace_data))
+			replace = &entry, replace_data = data;
+	}
+	const Move &best_move = move.IsNull() && same_position ? EntryMove(replace_data) : move;		// keep the best move of an earlier search of this position if there is no new one
+	const uint64_t &data = PackEntry(best_move, ScoreFromRoot(score, ply), depth, (generation << 2) | (bound + 1));		// the bound is stored off by one so a zero byte marks an empty entry
+	replace->check.store(key ^ data, std::memory_order_relaxed);
+	replace->data.store(data, std::memory_order_relaxed);
+}
+
+// returns how valuable the entry with the given data word is to keep, empty entries are worth the least
+int TranspositionTable::EntryWorth(const uint64_t &data) const noexcept {
+	if(!EntryGenerationAndBound(data))
+		return -1000;
+	return EntryDepth(data) - 8 * ((generation - (EntryGenerationAndBound(data) >> 2)) & 0x3F);
+}
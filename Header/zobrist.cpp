@@ -0,0 +1,38 @@
+#include "chess.h"
+
+// zobrist hashing implementation
+
+uint64_t ZOBRIST_PIECES[2][6][BOARD_SIZE*BOARD_SIZE];
+uint64_t ZOBRIST_CASTLING[ALL_CASTLING_RIGHTS+1];
+uint64_t ZOBRIST_EN_PASSANT[BOARD_SIZE];
+uint64_t ZOBRIST_BLACK_TO_MOVE;
+
+// fills the zobrist key tables with pseudo-random numbers, the seed is fixed so the keys are the same in every run
+bool InitZobrist() noexcept {
+	uint64_t state = 0x9E3779B97F4A7C15ULL;
+	auto NextRandom = [&state]() {		// splitmix64
+		uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	};
+	for(short color=0;color<2;++color)
+		for(short type=KING;type<=PAWN;++type)
+			for(short square=0;square<BOARD_SIZE*BOARD_SIZE;++square)
+				ZOBRIST_PIECES[color][type][square] = NextRandom();
+	uint64_t castling_keys[4];
+	for(short i=0;i<4;++i)
+		castling_keys[i] = NextRandom();
+	for(short rights=0;rights<=ALL_CASTLING_RIGHTS;++rights) {		// the key of a set of castling rights is the xor of the keys of each right
+		ZOBRIST_CASTLING[rights] = 0;
+		for(short i=0;i<4;++i)
+			if(rights & (1 << i))
+				ZOBRIST_CASTLING[rights] ^= castling_keys[i];
+	}
+	for(short file=0;file<BOARD_SIZE;++file)
+		ZOBRIST_EN_PASSANT[file] = NextRandom();
+	ZOBRIST_BLACK_TO_MOVE = NextRandom();
+	return true;
+}
+
+static const bool ZOBRIST_INITIALIZED = InitZobrist();
@@ -1,49 +1,479 @@
-#include "Header/chess.h"
-#include <iostream>
-#include <time.h>
-#include <windows.h>
-
-int main() {
-	srand((unsigned int)time(NULL));
-	Chess c("ArasDasDas", WHITE_BOT_DIFFICULTY, "MCihan899", BLACK_BOT_DIFFICULTY);
-	ShowWindow(GetConsoleWindow(), SW_MAXIMIZE);
-	if(AGAINST_BOT) {
-		do {
-			c.PrintBoard();
-			if(TWO_BOTS) {				// bot vs bot (no human)
-				MoveCursorToXY(RIGHT, DOWN + 3*BOARD_SIZE + 5);
-				std::cout << CLEAR_LINE << std::endl << std::endl << CLEAR_LINE;
-				while(c.BotsTurn());
-			}
-			else {
-				if(BOT_IS_WHITE)
-					while(true) {		// team black player vs team white bot
-						MoveCursorToXY(RIGHT, DOWN + 3*BOARD_SIZE + 5);
-						std::cout << CLEAR_LINE << std::endl << std::endl << CLEAR_LINE;
-						if(!c.BotsTurn())
-							break;
-						std::cout << std::endl << TO_RIGHT << "Enter move coordinates (x1,y1)->(x2,y2):";
-						std::cout << std::endl << std::endl << TO_RIGHT << "All possible moves:" << std::endl;
-						if(!c.PlayersTurn())
-							break;
-					}
-				else
-					while(true) {		// team white player vs team black bot
-						if(!c.PlayersTurn())
-							break;
-						MoveCursorToXY(RIGHT, DOWN + 3*BOARD_SIZE + 5);
-						std::cout << CLEAR_LINE << std::endl << std::endl << CLEAR_LINE;
-						if(!c.BotsTurn())
-							break;
-						std::cout << std::endl << TO_RIGHT << "Enter move coordinates (x1,y1)->(x2,y2):";
-						std::cout << std::endl << std::endl << TO_RIGHT << "All possible moves:" << std::endl;
-					}
-			}
-		} while(c.GameOver());
-		exit(0);
-	}
-	do {								// player vs player (no bots)
-		c.PrintBoard();
-		while(c.PlayersTurn());
-	} while(c.GameOver());
-}
+#include "Header/chess.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+// runs the perft tools, usage:
+// perft [-t threads] <depth> [fen]		counts the leaf nodes of the move generation tree
+// divide [-t threads] <depth> [fen]	same as perft but also prints the node count under each root move
+// perftsuite [-t threads] [epd file]	checks the node counts of the standard reference positions, or of the positions in the file
+int PerftCommand(int argc, char *argv[]) {
+	const std::string command = argv[1];
+	unsigned short threads = 1;
+	int i = 2;
+	if(i+1 < argc && std::string(argv[i]) == "-t") {
+		threads = std::max(1, atoi(argv[i+1]));
+		i += 2;
+	}
+	if(command == "perftsuite")
+		return (i < argc ? Chess::PerftFile(argv[i], threads) : Chess::PerftSuite(threads)) ? 0 : 1;
+	if((command != "perft" && command != "divide") || i >= argc) {
+		std::cerr << "Usage: " << argv[0] << " perft|divide [-t threads] <depth> [fen]" << std::endl << "       " << argv[0] << " perftsuite [-t threads] [epd file]" << std::endl;
+		return 1;
+	}
+	const unsigned short depth = atoi(argv[i++]);
+	std::string fen;
+	for(;i<argc;++i)
+		fen += std::string(argv[i]) + " ";
+	Chess c("White", 1, "Black", 1);
+	if(!fen.empty() && !c.LoadFEN(fen)) {
+		std::cerr << "Invalid FEN: " << fen << std::endl;
+		return 1;
+	}
+	c.PerftRoot(depth, threads, command == "divide");
+	return 0;
+}
+
+// checks the evaluation kernels against the incrementally updated evaluation, usage:
+// evalcheck [games] [network file]		plays the given number of random games and compares the kernels' scores in every position, 200 games by default,
+//										with a network file the incrementally updated accumulators and the network's output kernels are checked too
+int EvalCheckCommand(int argc, char *argv[]) {
+	std::shared_ptr<NeuralNetwork> network;
+	if(argc > 3 && !(network = std::make_shared<NeuralNetwork>())->Load(argv[3])) {
+		std::cerr << "Cannot load the neural network " << argv[3] << std::endl;
+		return 1;
+	}
+	return Chess::EvaluationSelfCheck(argc > 2 ? std::max(1, atoi(argv[2])) : 200, network) ? 0 : 1;
+}
+
+// compares the neural network evaluation with the piece-square table evaluation, usage:
+// evalbench [-g games] [-d depth] [-t threads] <network file>
+// prints how many positions each evaluation scores per second, statically and while moves are played and undone as in a search,
+// then plays a match of the given number of games (20 by default) from random openings between bots that search to the given depth
+// (4 by default), one with the piece-square tables and one with the network
+int EvalBenchCommand(int argc, char *argv[]) {
+	static const unsigned short POSITION_COUNT = 4096;
+	unsigned long long games = 20;
+	unsigned short depth = 4, threads = std::max(1u, std::thread::hardware_concurrency());
+	int i = 2;
+	for(;i+1<argc && argv[i][0] == '-';++i) {
+		const std::string option = argv[i];
+		if(option == "-g")				games = strtoull(argv[++i], nullptr, 10);
+		else if(option == "-d")			depth = std::max(1, atoi(argv[++i]));
+		else if(option == "-t")			threads = std::max(1, atoi(argv[++i]));
+	}
+	const auto &network = std::make_shared<NeuralNetwork>();
+	if(i+1 != argc || !network->Load(argv[i])) {
+		std::cerr << "Usage: " << argv[0] << " evalbench [-g games] [-d depth] [-t threads] <network file>" << std::endl;
+		return 1;
+	}
+	std::vector<Chess> positions;
+	Chess c("White", 1, "Black", 1);
+	MoveList all_moves;
+	while(positions.size() < POSITION_COUNT) {			// positions of random games
+		c.AllMoves(all_moves);
+		if(all_moves.Empty() || c.GetHalfmoveClock() >= 100)
+			c.LoadFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+		else {
+			c.MovePiece(all_moves[c.GetRandomNumber<unsigned short>(0, all_moves.Size()-1)]);
+			positions.push_back(c);
+		}
+	}
+	std::cout << "Neural network: " << network->GetHiddenSize() << " hidden neurons" << std::endl;
+	for(short use_network=0;use_network<2;++use_network) {
+		volatile float checksum = 0;	// keeps the evaluations from being optimized away
+		unsigned long long evaluations = 0;
+		for(auto &position : positions)
+			position.UseNetwork(use_network ? network : nullptr);
+		auto start = std::chrono::steady_clock::now();
+		for(short repeat=0;repeat<100;++repeat)
+			for(const auto &position : positions)
+				checksum += position.EvaluateBoard(position.GetTurn()), ++evaluations;
+		const double &static_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		const unsigned long long static_evaluations = evaluations;
+		evaluations = 0;
+		start = std::chrono::steady_clock::now();
+		for(auto &position : positions) {
+			position.AllMoves(all_moves);
+			for(const auto &move : all_moves) {
+				position.MovePiece(move);
+				checksum += position.EvaluateBoard(position.GetTurn()), ++evaluations;
+				position.MovePieceBack(move);
+			}
+		}
+		const double &search_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::cout << (use_network ? "Neural network: " : "Piece-square tables: ") << std::fixed << std::setprecision(0)
+		<< static_evaluations / std::max(static_seconds, 1e-9) << " static evaluations/sec, " << evaluations / std::max(search_seconds, 1e-9)
+		<< " move + evaluation + undo/sec" << std::endl;
+	}
+	std::vector<std::string> openings;			// eight random halfmoves from the start position, each one is played with both colors
+	while(openings.size() < (games + 1) / 2) {
+		c.LoadFEN("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+		for(short ply=0;ply<8 && (c.AllMoves(all_moves), !all_moves.Empty());++ply)
+			c.MovePiece(all_moves[c.GetRandomNumber<unsigned short>(0, all_moves.Size()-1)]);
+		openings.push_back(c.GetFEN());
+	}
+	MatchPlayer players[2];
+	for(auto &player : players)
+		player.limits.max_depth = depth;
+	players[1].network = network;
+	const MatchScore &score = MatchRunner(players[0], players[1], openings, threads).Run(games, SprtSettings(), nullptr);
+	std::cout << "Match at depth " << depth << ", neural network against piece-square tables: +" << score.losses << " =" << score.draws << " -" << score.wins
+	<< "\tElo: " << std::setprecision(1) << -score.EloDifference() << " +/- " << score.EloError() << std::endl;
+	return 0;
+}
+
+// runs the search scaling benchmark, usage:
+// bench [depth]		searches a fixed set of positions to the given depth with 1, 2, 4, 8 and 16 threads and prints the time it took
+//					and how many pawn structure evaluations and static evaluations were found in the pawn hash tables and the evaluation cache
+int BenchCommand(int argc, char *argv[]) {
+	static const char *POSITIONS[] = {
+		"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+		"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+		"r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+		"rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+		"8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1"};
+	SearchLimits limits;
+	limits.max_depth = argc > 2 ? std::max(1, atoi(argv[2])) : 5;
+	double single_thread_time = 0;
+	std::cout << "Time to depth " << limits.max_depth << " (" << std::thread::hardware_concurrency() << " hardware threads)" << std::endl;
+	for(unsigned short threads=1;threads<=16;threads*=2) {
+		unsigned long long nodes = 0;
+		double pawn_hash_hit_rate = 0;
+		unsigned long long eval_cache_hits = 0, eval_cache_misses = 0;
+		const auto &start = std::chrono::steady_clock::now();
+		for(const char *fen : POSITIONS) {
+			Chess c("White", 1, "Black", 1);
+			c.LoadFEN(fen);
+			Bot bot("Bench", 1);			// a new bot for every position so each search starts with an empty transposition table
+			bot.SetThreads(threads);
+			bot.GetIdealMove(c, limits);
+			nodes += bot.GetNodes();
+			pawn_hash_hit_rate += bot.GetPawnHashHitRate() / (sizeof(POSITIONS) / sizeof(*POSITIONS));
+			eval_cache_hits += bot.GetEvalCacheHits();
+			eval_cache_misses += bot.GetEvalCacheMisses();
+		}
+		const double &seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		if(threads == 1)
+			single_thread_time = seconds;
+		std::cout << "Threads: " << threads << "\tTime: " << std::fixed << std::setprecision(3) << seconds << " s\tSpeedup: " << std::setprecision(2)
+		<< single_thread_time / seconds << "\tNodes: " << nodes << "\tNodes/sec: " << static_cast<unsigned long long>(nodes / std::max(seconds, 1e-9))
+		<< "\tPawn hash hits: " << std::setprecision(1) << 100 * pawn_hash_hit_rate << "%\tEval cache hits: "
+		<< 100.0 * eval_cache_hits / std::max(eval_cache_hits + eval_cache_misses, 1ull) << "%" << std::endl;
+	}
+	return 0;
+}
+
+// prints the static evaluation of every position the reader reads, see "AnalyzeCommand", the positions are evaluated in batches
+int StaticEvaluationCommand(EpdReader &reader) {
+	static const size_t BATCH_SIZE = 1024;
+	PawnHashTable pawn_table;
+	std::vector<PackedBoard> batch;
+	std::vector<std::string> fens, tags;
+	std::vector<float> scores;
+	EpdRecord record;
+	unsigned long long count = 0;
+	for(bool more = true; more;) {
+		batch.clear();
+		fens.clear();
+		tags.clear();
+		while(batch.size() < BATCH_SIZE && (more = reader.Next(record))) {
+			const std::string &id = record.GetOperation("id");
+			++count;
+			Chess c("White", 1, "Black", 1);
+			if(!c.LoadFEN(record.fen)) {
+				std::cerr << "Invalid FEN: id \"" << (id.empty() ? std::to_string(count) : id) << "\"" << std::endl;
+				continue;
+			}
+			batch.push_back(c.GetPackedBoard());
+			fens.push_back(c.GetFEN());
+			tags.push_back(id.empty() ? std::to_string(count) : id);
+		}
+		Chess::EvaluateBoards(batch, scores, &pawn_table);
+		for(size_t i=0;i<batch.size();++i) {
+			const std::string &fen = fens[i];
+			std::cout << fen.substr(0, fen.find(' ', fen.find(' ', fen.find(' ', fen.find(' ') + 1) + 1) + 1)) << " ce " << static_cast<long>(std::lround(scores[i] * 10))
+			<< "; id \"" << tags[i] << "\";" << std::endl;
+		}
+	}
+	std::cerr << count << " positions evaluated" << std::endl;
+	return 0;
+}
+
+// analyzes every position of an EPD file on a pool of threads and prints the results as EPD lines, usage:
+// analyze [-t threads] [-d depth] [-n nodes] [-m milliseconds] [-h hash] [-u] [-e] <epd file>
+// the "acd" (depth), "acn" (nodes) and "acs" (seconds) operations of a position override the limits given here, the output has the same
+// operations for the finished search, "ce" for the score in centipawns, "pm" for the best move in coordinate notation and the position's "id",
+// or its number in the file if it has none, the results are printed in the order of the file unless "-u" is given,
+// with "-e" the positions are not searched and only their static evaluations are printed as "ce", evaluated in batches on this thread
+int AnalyzeCommand(int argc, char *argv[]) {
+	unsigned short threads = std::max(1u, std::thread::hardware_concurrency());
+	size_t hash_megabytes = HASH_SIZE_MB;
+	bool ordered = true, static_only = false;
+	SearchLimits default_limits;
+	default_limits.max_depth = 5;
+	int i = 2;
+	for(;i<argc && argv[i][0] == '-';++i) {
+		const std::string option = argv[i];
+		if(option == "-u")
+			ordered = false;
+		else if(option == "-e")
+			static_only = true;
+		else if(i+1 < argc && option == "-t")	threads = std::max(1, atoi(argv[++i]));
+		else if(i+1 < argc && option == "-d")	default_limits.max_depth = std::max(1, atoi(argv[++i]));
+		else if(i+1 < argc && option == "-n")	default_limits.max_nodes = strtoull(argv[++i], nullptr, 10);
+		else if(i+1 < argc && option == "-m")	default_limits.max_time = atof(argv[++i]) / 1000;
+		else if(i+1 < argc && option == "-h")	hash_megabytes = std::max(1, atoi(argv[++i]));
+	}
+	EpdReader reader(i < argc ? argv[i] : "");
+	if(i >= argc || !reader.IsOpen()) {
+		std::cerr << "Usage: " << argv[0] << " analyze [-t threads] [-d depth] [-n nodes] [-m milliseconds] [-h hash] [-u] [-e] <epd file>" << std::endl;
+		return 1;
+	}
+	EpdRecord record;
+	if(static_only)
+		return StaticEvaluationCommand(reader);
+	const unsigned long long &count = BatchAnalyzer(threads, hash_megabytes, ordered).Run([&](BatchJob &job) {
+		if(!reader.Next(record))
+			return false;
+		job.fen = record.fen;
+		job.limits = default_limits;
+		const std::string &depth = record.GetOperation("acd"), &nodes = record.GetOperation("acn"), &seconds = record.GetOperation("acs");
+		if(!depth.empty())		job.limits.max_depth = std::max(1, atoi(depth.c_str()));
+		if(!nodes.empty())		job.limits.max_nodes = strtoull(nodes.c_str(), nullptr, 10);
+		if(!seconds.empty())	job.limits.max_time = atof(seconds.c_str());
+		const std::string &id = record.GetOperation("id");
+		job.tag = id.empty() ? std::to_string(job.index + 1) : id;
+		return true;
+	}, [](const BatchResult &result) {
+		if(!result.valid) {
+			std::cerr << "Invalid FEN: id \"" << result.tag << "\"" << std::endl;
+			return;
+		}
+		std::cout << result.fen.substr(0, result.fen.find(' ', result.fen.find(' ', result.fen.find(' ', result.fen.find(' ') + 1) + 1) + 1))
+		<< " acd " << result.depth << "; acn " << result.nodes << "; acs " << std::fixed << std::setprecision(3) << result.time << "; ce "
+		<< static_cast<long>(std::lround(result.score * 10)) << "; pm " << (result.best_move.IsNull() ? "0000" : result.best_move.ToString())
+		<< "; id \"" << result.tag << "\";" << std::endl;
+	});
+	std::cerr << count << " positions analyzed" << std::endl;
+	return 0;
+}
+
+// reads the settings of a match player written like "depth=4,nodes=20000,time=100,hash=16,threads=1,nnue=file", the time is in milliseconds
+// per move and "nnue" is the neural network the bot evaluates with, returns false if the text has an unknown setting or the network cannot be loaded
+bool ParseMatchPlayer(const std::string &text, MatchPlayer &player) {
+	std::istringstream settings(text);
+	for(std::string setting;std::getline(settings, setting, ',');) {
+		const size_t &equals = setting.find('=');
+		const std::string &name = setting.substr(0, equals), &value = equals == std::string::npos ? "" : setting.substr(equals + 1);
+		if(name == "depth")				player.limits.max_depth = std::max(1, atoi(value.c_str()));
+		else if(name == "nodes")		player.limits.max_nodes = strtoull(value.c_str(), nullptr, 10);
+		else if(name == "time")			player.limits.max_time = atof(value.c_str()) / 1000;
+		else if(name == "hash")			player.hash_megabytes = std::max(1, atoi(value.c_str()));
+		else if(name == "threads")		player.threads = std::max(1, atoi(value.c_str()));
+		else if(name == "nnue") {
+			const auto &network = std::make_shared<NeuralNetwork>();
+			if(!network->Load(value))
+				return false;
+			player.network = network;
+		}
+		else
+			return false;
+	}
+	return true;
+}
+
+// plays a match between two bots and prints the results, usage:
+// match [-t threads] [-g games] [-o openings file] [-sprt elo0 elo1] <first bot> <second bot>
+// each bot is written like "depth=4,nodes=20000,time=100,hash=16,threads=1", the openings file is an EPD or FEN file whose every position
+// is played twice with the colors swapped, with "-sprt" the match stops as soon as the test decides whether the first bot is elo0 or elo1 stronger
+int MatchCommand(int argc, char *argv[]) {
+	unsigned short threads = std::max(1u, std::thread::hardware_concurrency());
+	unsigned long long games = 1000;
+	std::string openings_file;
+	SprtSettings sprt;
+	int i = 2;
+	for(;i+1<argc && argv[i][0] == '-';++i) {
+		const std::string option = argv[i];
+		if(option == "-t")				threads = std::max(1, atoi(argv[++i]));
+		else if(option == "-g")			games = strtoull(argv[++i], nullptr, 10);
+		else if(option == "-o")			openings_file = argv[++i];
+		else if(option == "-sprt" && i+2 < argc) {
+			sprt.enabled = true;
+			sprt.elo0 = atof(argv[++i]);
+			sprt.elo1 = atof(argv[++i]);
+		}
+	}
+	MatchPlayer players[2];
+	if(i+2 != argc || !ParseMatchPlayer(argv[i], players[0]) || !ParseMatchPlayer(argv[i+1], players[1])) {
+		std::cerr << "Usage: " << argv[0] << " match [-t threads] [-g games] [-o openings file] [-sprt elo0 elo1] <first bot> <second bot>" << std::endl;
+		std::cerr << "       a bot is written like depth=4,nodes=20000,time=100,hash=16,threads=1,nnue=file" << std::endl;
+		return 1;
+	}
+	std::vector<std::string> openings;
+	if(!openings_file.empty()) {
+		EpdReader reader(openings_file);
+		if(!reader.IsOpen()) {
+			std::cerr << "Cannot open " << openings_file << std::endl;
+			return 1;
+		}
+		for(EpdRecord record;reader.Next(record);)
+			openings.push_back(record.fen);
+	}
+	auto PrintScore = [&sprt](const MatchScore &score) {
+		std::cout << "Games: " << score.Games() << "\tW: " << score.wins << "\tD: " << score.draws << "\tL: " << score.losses << std::fixed << std::setprecision(1)
+		<< "\tElo: " << score.EloDifference() << " +/- " << score.EloError() << std::setprecision(3) << "\tLOS: " << score.LikelihoodOfSuperiority();
+		if(sprt.enabled)
+			std::cout << std::setprecision(2) << "\tLLR: " << score.LogLikelihoodRatio(sprt.elo0, sprt.elo1) << " (" << sprt.LowerBound() << ", " << sprt.UpperBound() << ")";
+		std::cout << std::endl;
+	};
+	const MatchScore &score = MatchRunner(players[0], players[1], openings, threads).Run(games, sprt, [&PrintScore](const MatchScore &score) {
+		if(score.Games() % 10 == 0)
+			PrintScore(score);
+	});
+	std::cout << std::endl << "Final result" << std::endl;
+	PrintScore(score);
+	if(sprt.enabled) {
+		const double &llr = score.LogLikelihoodRatio(sprt.elo0, sprt.elo1);
+		std::cout << "SPRT: " << (llr >= sprt.UpperBound() ? "H1 accepted" : llr <= sprt.LowerBound() ? "H0 accepted" : "inconclusive") << std::endl;
+	}
+	return 0;
+}
+
+// makes an opening book of a file of games, each line of which is one game from the starting position in long algebraic notation, usage:
+// makebook [-d halfmoves] <games file> <book file>
+int MakeBookCommand(int argc, char *argv[]) {
+	unsigned short depth = BOOK_DEPTH;
+	int i = 2;
+	if(i+1 < argc && std::string(argv[i]) == "-d") {
+		depth = std::max(1, atoi(argv[i+1]));
+		i += 2;
+	}
+	if(i+2 != argc) {
+		std::cerr << "Usage: " << argv[0] << " makebook [-d halfmoves] <games file> <book file>" << std::endl;
+		return 1;
+	}
+	if(!OpeningBook::Build(argv[i], argv[i+1], depth)) {
+		std::cerr << "Cannot make the book " << argv[i+1] << " of " << argv[i] << std::endl;
+		return 1;
+	}
+	std::cout << OpeningBook(argv[i+1]).Size() << " entries written to " << argv[i+1] << std::endl;
+	return 0;
+}
+
+// makes endgame tablebases and the tablebases they depend on, usage:
+// tbgen [-t threads] [-o directory] <table>...		e.g. "tbgen KQK KRK KPK KBNK", tables already in the directory are read instead of made again
+int TablebaseCommand(int argc, char *argv[]) {
+	unsigned short threads = std::max(1u, std::thread::hardware_concurrency());
+	std::string directory = ".";
+	int i = 2;
+	for(;i+1<argc && argv[i][0] == '-';i+=2) {
+		if(std::string(argv[i]) == "-t")
+			threads = std::max(1, atoi(argv[i+1]));
+		else if(std::string(argv[i]) == "-o")
+			directory = argv[i+1];
+	}
+	if(i >= argc) {
+		std::cerr << "Usage: " << argv[0] << " tbgen [-t threads] [-o directory] <table>..." << std::endl;
+		return 1;
+	}
+	Tablebases tablebases;
+	const auto &start = std::chrono::steady_clock::now();
+	for(;i<argc;++i)
+		if(!tablebases.Generate(argv[i], directory, threads, [](const std::string &summary) { std::cout << summary << std::endl; })) {
+			std::cerr << "Cannot make the table " << argv[i] << std::endl;
+			return 1;
+		}
+	std::cout << "Done in " << std::fixed << std::setprecision(1) << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " seconds" << std::endl;
+	return 0;
+}
+
+int main(int argc, char *argv[]) {
+	if(argc > 1) {
+		if(std::string(argv[1]) == "bench")
+			return BenchCommand(argc, argv);
+		if(std::string(argv[1]) == "evalcheck")
+			return EvalCheckCommand(argc, argv);
+		if(std::string(argv[1]) == "fencheck")
+			return Chess::FenSelfCheck() ? 0 : 1;
+		if(std::string(argv[1]) == "evalbench")
+			return EvalBenchCommand(argc, argv);
+		if(std::string(argv[1]) == "analyze")
+			return AnalyzeCommand(argc, argv);
+		if(std::string(argv[1]) == "match")
+			return MatchCommand(argc, argv);
+		if(std::string(argv[1]) == "makebook")
+			return MakeBookCommand(argc, argv);
+		if(std::string(argv[1]) == "tbgen")
+			return TablebaseCommand(argc, argv);
+		return PerftCommand(argc, argv);
+	}
+	Chess c("ArasDasDas", WHITE_BOT_DIFFICULTY, "MCihan899", BLACK_BOT_DIFFICULTY);
+	c.SeedRandom(time(NULL));
+	if(std::string(BOOK_FILE) != "") {
+		const auto &book = std::make_shared<OpeningBook>(BOOK_FILE);
+		if(book->IsOpen())
+			c.SetBook(book);
+	}
+	if(std::string(TABLEBASE_PATH) != "") {
+		const auto &tablebases = std::make_shared<Tablebases>();
+		if(tablebases->Load(TABLEBASE_PATH))
+			c.SetTablebases(tablebases);
+	}
+	if(std::string(NNUE_FILE) != "") {
+		const auto &network = std::make_shared<NeuralNetwork>();
+		if(network->Load(NNUE_FILE))
+			c.SetNetwork(network);
+	}
+#ifdef _WIN32
+	ShowWindow(GetConsoleWindow(), SW_MAXIMIZE);
+#endif
+	if(AGAINST_BOT) {
+		do {
+			PrintBoard(c);
+			if(TWO_BOTS) {				// bot vs bot (no human)
+				MoveCursorToXY(RIGHT, DOWN + 3*BOARD_SIZE + 5);
+				std::cout << CLEAR_LINE << std::endl << std::endl << CLEAR_LINE;
+				while(BotsTurn(c));
+			}
+			else {
+				if(BOT_IS_WHITE)
+					while(true) {		// team black player vs team white bot
+						MoveCursorToXY(RIGHT, DOWN + 3*BOARD_SIZE + 5);
+						std::cout << CLEAR_LINE << std::endl << std::endl << CLEAR_LINE;
+						if(!BotsTurn(c))
+							break;
+						std::cout << std::endl << TO_RIGHT << "Enter move coordinates (x1,y1)->(x2,y2):";
+						std::cout << std::endl << std::endl << TO_RIGHT << "All possible moves:" << std::endl;
+						if(!PlayersTurn(c))
+							break;
+					}
+				else
+					while(true) {		// team white player vs team black bot
+						if(!PlayersTurn(c))
+							break;
+						MoveCursorToXY(RIGHT, DOWN + 3*BOARD_SIZE + 5);
+						std::cout << CLEAR_LINE << std::endl << std::endl << CLEAR_LINE;
+						if(!BotsTurn(c))
+							break;
+						std::cout << std::endl << TO_RIGHT << "Enter move coordinates (x1,y1)->(x2,y2):";
+						std::cout << std::endl << std::endl << TO_RIGHT << "All possible moves:" << std::endl;
+					}
+			}
+		} while(GameOver(c));
+		exit(0);
+	}
+	do {								// player vs player (no bots)
+		PrintBoard(c);
+		while(PlayersTurn(c));
+	} while(GameOver(c));
+}
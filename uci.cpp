@@ -0,0 +1,269 @@
+#include "Header/chess.h"
+#include <iostream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// universal chess interface (UCI) front end, reads commands from the standard input and answers on the standard output,
+// the search runs on its own thread so "stop", "isready" and "ponderhit" are answered while the engine is thinking
+
+#define STARTING_FEN "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1"
+#define MOVE_OVERHEAD 0.05			// seconds kept aside from every move for the communication with the GUI
+#define MOVES_TO_GO 30				// the number of moves the remaining time is divided between if the GUI does not tell
+
+// the state of the engine between commands
+struct UciEngine {
+	Chess game = Chess("White", 1, "Black", 1);		// the position set up by the last "position" command
+	Bot bot = Bot("Chess Bot", 1);
+	std::thread search_thread, ponder_timer;
+	std::mutex mutex;						// guards the flags below and the standard output
+	std::condition_variable changed;		// notified whenever one of the flags below changes
+	bool searching = false;					// true from "go" until the best move is printed
+	bool wait_for_stop = false;				// true while an infinite or pondering search must not print its best move, even if it has finished
+	bool search_finished = false;			// true once the search has returned its best move
+	SearchLimits ponder_limits;				// the limits of the last "go ponder", its time limit starts to count once the pondered move is played
+	std::shared_ptr<OpeningBook> book;		// the book set with the "BookFile" option, only used if "OwnBook" is on
+	bool own_book = false;
+	unsigned short book_depth = BOOK_DEPTH;
+	std::shared_ptr<NeuralNetwork> network;	// the network loaded with the "EvalFile" option, only used if "UseNNUE" is on
+	bool use_network = false;
+};
+
+// prints the given line on the standard output, the output is flushed so the GUI gets it at once
+static void PrintLine(UciEngine &engine, const std::string &line) {
+	std::lock_guard<std::mutex> lock(engine.mutex);
+	std::cout << line << std::endl;
+}
+
+// returns the score part of an "info" line, "mate" and the moves to checkmate for a checkmate or tablebase score, negative if the engine
+// is the one mated, otherwise "cp" and the score converted from points (a pawn is 10 points) to centipawns
+static std::string ScoreText(const float &score) {
+	if(std::fabs(score) < DISTANCE_SCORE)
+		return "cp " + std::to_string(std::lround(score * 10));
+	const long &plies = std::lround(std::fabs(score) >= MATE_SCORE - MAX_PLY ? MATE_SCORE - std::fabs(score) : TABLEBASE_WIN - std::fabs(score));
+	return "mate " + std::to_string(score > 0 ? (plies + 1) / 2 : -plies / 2);
+}
+
+// returns the "info" line of the given iteration report
+static std::string InfoLine(const SearchReport &report) {
+	std::ostringstream line;
+	line << "info depth " << report.depth << " score " << ScoreText(report.score) << " nodes " << report.nodes
+	<< " nps " << static_cast<unsigned long long>(report.nodes / std::max(report.time, 1e-3)) << " time " << static_cast<unsigned long long>(report.time * 1000) << " pv";
+	for(const auto &move : report.principal_variation)
+		line << " " << move.ToString();
+	return line.str();
+}
+
+// stops the running search if there is one and waits until it has printed its best move
+static void StopSearch(UciEngine &engine) {
+	if(!engine.search_thread.joinable())
+		return;
+	{
+		std::lock_guard<std::mutex> lock(engine.mutex);
+		engine.wait_for_stop = false;
+	}
+	engine.changed.notify_all();
+	engine.bot.Stop();
+	engine.search_thread.join();
+	if(engine.ponder_timer.joinable())
+		engine.ponder_timer.join();
+}
+
+// returns the seconds the engine can spend on the move with the given time left on its clock and increment, in milliseconds
+static double MoveTime(const double &time_left, const double &increment, const unsigned short &moves_to_go) {
+	const double &seconds = (time_left / std::max<unsigned short>(moves_to_go, 1) + increment / 2) / 1000;
+	return std::max(std::min(seconds, time_left / 1000 - MOVE_OVERHEAD), 0.01);
+}
+
+// handles the "go" command, the limits are read from the command and the search is started on the search thread
+static void Go(UciEngine &engine, std::istringstream &command) {
+	StopSearch(engine);
+	SearchLimits limits;
+	double time_left[2] = {0, 0}, increment[2] = {0, 0};		// [is_white], in milliseconds
+	unsigned short moves_to_go = MOVES_TO_GO;
+	bool ponder = false;
+	std::string token;
+	while(command >> token) {
+		if(token == "depth")				command >> limits.max_depth;
+		else if(token == "nodes")			command >> limits.max_nodes;
+		else if(token == "movetime")		{ command >> limits.max_time;		limits.max_time /= 1000; }
+		else if(token == "wtime")			command >> time_left[true];
+		else if(token == "btime")			command >> time_left[false];
+		else if(token == "winc")			command >> increment[true];
+		else if(token == "binc")			command >> increment[false];
+		else if(token == "movestogo")		command >> moves_to_go;
+		else if(token == "infinite")		limits.infinite = true;
+		else if(token == "ponder")			ponder = true;
+	}
+	const bool &turn = engine.game.GetTurn();
+	if(time_left[turn] > 0 && !limits.max_time)
+		limits.max_time = MoveTime(time_left[turn], increment[turn], moves_to_go);
+	{
+		std::lock_guard<std::mutex> lock(engine.mutex);
+		engine.searching = true;
+		engine.search_finished = false;
+		engine.wait_for_stop = limits.infinite || ponder;
+		engine.ponder_limits = limits;
+	}
+	if(ponder)
+		limits.max_time = 0;			// the clock starts when the GUI sends "ponderhit", the depth and node limits hold all along
+	engine.bot.ResetStop();			// cleared here rather than on the search thread so a "stop" right after "go" is not lost
+	engine.search_thread = std::thread([&engine, limits](Chess position) {
+		MoveList principal_variation;
+		engine.bot.SetReport([&engine, &principal_variation](const SearchReport &report) {
+			principal_variation = report.principal_variation;
+			PrintLine(engine, InfoLine(report));
+		});
+		const Move &best_move = engine.bot.GetIdealMove(position, limits);
+		engine.bot.SetReport(nullptr);
+		std::unique_lock<std::mutex> lock(engine.mutex);
+		engine.search_finished = true;
+		engine.changed.notify_all();
+		engine.changed.wait(lock, [&engine]() { return !engine.wait_for_stop; });
+		std::cout << "bestmove " << (best_move.IsNull() ? "0000" : best_move.ToString());
+		if(principal_variation.Size() > 1 && principal_variation[0] == best_move)
+			std::cout << " ponder " << principal_variation[1].ToString();
+		std::cout << std::endl;
+		engine.searching = false;
+		engine.changed.notify_all();
+	}, engine.game);
+}
+
+// handles the "ponderhit" command, the opponent played the pondered move so the search goes on as a normal search of the same position
+// with the limits of the "go ponder" command: a search that already reached its depth or node limit prints its best move at once,
+// with a time limit its clock is started now and the search is stopped when the time is up
+static void PonderHit(UciEngine &engine) {
+	std::lock_guard<std::mutex> lock(engine.mutex);
+	if(!engine.searching || !engine.wait_for_stop)
+		return;
+	if(engine.ponder_limits.infinite)
+		return;				// an infinite ponder search is still stopped with "stop"
+	engine.wait_for_stop = false;
+	engine.changed.notify_all();
+	if(engine.ponder_limits.max_time <= 0)
+		return;
+	const auto &deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(engine.ponder_limits.max_time);
+	engine.ponder_timer = std::thread([&engine, deadline]() {
+		std::unique_lock<std::mutex> lock(engine.mutex);
+		if(!engine.changed.wait_until(lock, deadline, [&engine]() { return engine.search_finished; }))
+			engine.bot.Stop();
+	});
+}
+
+// handles the "position" command, sets up the given position and plays the given moves on it
+static void Position(UciEngine &engine, std::istringstream &command) {
+	StopSearch(engine);
+	std::string token, fen;
+	command >> token;
+	if(token == "startpos")
+		fen = STARTING_FEN;
+	else if(token == "fen")
+		while(command >> token && token != "moves")
+			fen += token + " ";
+	if(!engine.game.LoadFEN(fen)) {
+		PrintLine(engine, "info string invalid position");
+		return;
+	}
+	while(token != "moves" && command >> token);
+	while(command >> token) {
+		const Move &move = engine.game.ParseMove(token);
+		if(move.IsNull()) {
+			PrintLine(engine, "info string illegal move " + token);
+			return;
+		}
+		engine.game.PlayMove(move);
+	}
+}
+
+// handles the "setoption" command
+static void SetOption(UciEngine &engine, std::istringstream &command) {
+	StopSearch(engine);
+	std::string token, name, value;
+	command >> token;					// "name"
+	while(command >> token && token != "value")
+		name += (name.empty() ? "" : " ") + token;
+	std::getline(command >> std::ws, value);		// the rest of the line, so file names may contain spaces
+	if(name == "Hash")
+		engine.bot.GetTranspositionTable().Resize(std::max(1, atoi(value.c_str())));
+	else if(name == "Threads")
+		engine.bot.SetThreads(std::max(1, atoi(value.c_str())));
+	else if(name == "OwnBook" || name == "BookFile" || name == "BookDepth") {
+		if(name == "OwnBook")
+			engine.own_book = value == "true";
+		else if(name == "BookDepth")
+			engine.book_depth = std::max(0, atoi(value.c_str()));
+		else if(value.empty() || value == "<empty>")
+			engine.book = nullptr;
+		else if(!(engine.book = std::make_shared<OpeningBook>(value))->IsOpen()) {
+			engine.book = nullptr;
+			PrintLine(engine, "info string cannot open the book " + value);
+		}
+		engine.bot.SetBook(engine.own_book ? engine.book : nullptr, engine.book_depth);
+	}
+	else if(name == "UseNNUE" || name == "EvalFile") {
+		if(name == "UseNNUE")
+			engine.use_network = value == "true";
+		else if(value.empty() || value == "<empty>")
+			engine.network = nullptr;
+		else if(!(engine.network = std::make_shared<NeuralNetwork>())->Load(value)) {
+			engine.network = nullptr;
+			PrintLine(engine, "info string cannot load the neural network " + value);
+		}
+		engine.bot.SetNetwork(engine.use_network ? engine.network : nullptr);
+	}
+	else if(name == "TablebasePath") {
+		const auto &tablebases = std::make_shared<Tablebases>();
+		const unsigned short &loaded = value.empty() || value == "<empty>" ? 0 : tablebases->Load(value);
+		engine.bot.SetTablebases(loaded ? tablebases : nullptr);
+		PrintLine(engine, "info string " + std::to_string(loaded) + " tablebases loaded");
+	}
+}
+
+int main() {
+	std::ios::sync_with_stdio(false);
+	UciEngine engine;
+	std::string line;
+	while(std::getline(std::cin, line)) {
+		std::istringstream command(line);
+		std::string token;
+		command >> token;
+		if(token == "uci") {
+			PrintLine(engine, "id name chess-bot\nid author Aras Gungore");
+			PrintLine(engine, "option name Hash type spin default " + std::to_string(HASH_SIZE_MB) + " min 1 max 65536");
+			PrintLine(engine, "option name Threads type spin default " + std::to_string(BOT_THREADS) + " min 1 max 256");
+			PrintLine(engine, "option name Ponder type check default false");
+			PrintLine(engine, "option name OwnBook type check default false");
+			PrintLine(engine, "option name BookFile type string default <empty>");
+			PrintLine(engine, "option name BookDepth type spin default " + std::to_string(BOOK_DEPTH) + " min 0 max 1000");
+			PrintLine(engine, "option name TablebasePath type string default <empty>");
+			PrintLine(engine, "option name UseNNUE type check default false");
+			PrintLine(engine, "option name EvalFile type string default <empty>");
+			PrintLine(engine, "uciok");
+		}
+		else if(token == "isready")
+			PrintLine(engine, "readyok");
+		else if(token == "ucinewgame") {
+			StopSearch(engine);
+			engine.bot.GetTranspositionTable().Clear();
+		}
+		else if(token == "position")
+			Position(engine, command);
+		else if(token == "go")
+			Go(engine, command);
+		else if(token == "stop")
+			StopSearch(engine);
+		else if(token == "ponderhit")
+			PonderHit(engine);
+		else if(token == "setoption")
+			SetOption(engine, command);
+		else if(token == "quit")
+			break;
+	}
+	StopSearch(engine);
+	return 0;
+}